@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * gameBench.cc
+ *
+ * Benchmarks of the game's hot paths, reported as JSON on stdout:
+ *  - layout_parse/<config>:  labelling a configuration (Layout constructor)
+ *  - floor_build/<config>:   building a floor from it (Floor constructor)
+ *  - floor_reset/<config>:   rebuilding a floor in place from it (Floor::reset)
+ *  - layout_generate:        generating a random board (see Generator)
+ *  - floor_random:           rebuilding a floor on a generated board, which
+ *                            also populates it (generation + populate)
+ *  - turn_enemies/<config>:  a turn of the enemies, with the PC standing still
+ *  - turn_enemies_exact/<config>: the same with --exact
+ *  - print_floor/<config>:   printing the floor (operator<<)
+ *  - get_atk/<n>:            Player::getAtk with n temporary potions
+ *  - game:                   a 5-floor game, by a PC walking to the stairs
+ *                            and attacking whatever is in its way (healed
+ *                            every turn, so that it reaches the last floor)
+ * Every benchmark is repeated, and draws from streams seeded the same way
+ * every run.
+ *
+ * Usage: ./gameBench [--option ...] config ... > bench.json
+ *        (options as for the game; --threads defaults to 1)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <string>
+#include <chrono>
+#include "game.h"
+#include "floor.h"
+#include "floorBuilder.h"
+#include "flowField.h"
+#include "cell.h"
+#include "pc.h"
+#include "enemy.h"
+#include "layout.h"
+#include "generator.h"
+#include "potionDecorator.h"
+#include "rng.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+namespace {
+    // times every benchmark is measured
+    const int REPETITIONS = 5;
+
+    // turns after which a scripted PC gives up on reaching the stairs
+    const int MAX_TURNS_PER_FLOOR = 2000;
+
+    // seed of every game played by the scripted PC, so that every repetition
+    // plays the same game
+    const unsigned int GAME_SEED = 1;
+
+    // output that is thrown away
+    class NullBuffer : public streambuf {
+      protected:
+        int overflow(int c) { return c; }
+        streamsize xsputn(const char *, streamsize n) { return n; }
+    };
+
+    NullBuffer nullBuffer;
+    ostream nowhere(&nullBuffer);
+
+    // measurements of a benchmark
+    struct Result {
+        string name;
+        int iterations;
+        double minNs, medianNs;
+    };
+
+    vector<Result> results;
+
+    // keeps the compiler from dropping the work measured
+    volatile long long sink;
+
+    /*******************************************************************************
+     * measure(name, iterations, op) times iterations calls of op, REPETITIONS
+     *  times (after one call to warm up), and records the time per call
+     * time: O(REPETITIONS * iterations * time of op)
+     * *****************************************************************************/
+    void measure(const string &name, const int iterations, const function<void()> &op) {
+        op();
+        vector<double> perOp;
+        for (int rep = 0; rep < REPETITIONS; ++rep) {
+            const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) op();
+            const chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+            perOp.push_back(elapsed.count() / iterations);
+        } // for
+        sort(perOp.begin(), perOp.end());
+        Result r = {name, iterations, perOp.front(), perOp[perOp.size() / 2]};
+        results.push_back(r);
+        cerr << name << ": " << r.medianNs << " ns" << endl;
+    } // measure()
+
+    // reads the rows of configuration filename, as Layout::load() does
+    vector<string> readRows(const string &filename) {
+        ifstream in(filename.c_str());
+        vector<string> rows;
+        string row;
+        while (getline(in, row)) {
+            if (!row.empty() && row[row.size() - 1] == '\r') row.erase(row.size() - 1);
+            rows.push_back(row);
+        } // while
+        while (!rows.empty() && rows.back().empty()) rows.pop_back();
+        return rows;
+    } // readRows()
+
+    // name of configuration filename, without its directory and extension
+    string baseName(const string &filename) {
+        const size_t slash = filename.find_last_of("/\\");
+        const string base = slash == string::npos ? filename : filename.substr(slash + 1);
+        return base.substr(0, base.find('.'));
+    } // baseName()
+
+    // finds the stairs of fl
+    Cell& findStairs(const Floor &fl) {
+        for (int row = 0; row < fl.getNumRows(); ++row) {
+            for (int col = 0; col < fl.getNumCols(); ++col) {
+                Cell *cell = fl.getCell(row, col);
+                if (cell && cell->isStairs()) return *cell;
+            } // for
+        } // for
+        throw GameError();
+    } // findStairs()
+
+    /*******************************************************************************
+     * step(pc, toStairs) has pc take a step towards the stairs, attacking the
+     *  enemy in its way if any (steps elsewhere if it cannot go that way)
+     * exceptions: throws ReachedStairs() once pc reaches the stairs
+     * time: O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    void step(PC &pc, const FlowField &toStairs) {
+        const Cell &location = *pc.getLocation();
+        unsigned int mask = 0;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            if (location.getNeighbor(dir)) mask |= 1u << dir;
+        } // for
+        int dir = toStairs.downhill(location, mask);
+        if (dir == -1) {
+            // picks the k-th walkable direction
+            int numValid = 0;
+            for (unsigned int m = mask; m; m &= m - 1) ++numValid;
+            if (!numValid) return;
+            int k = Rng::current().next() % numValid;
+            for (dir = 0; !(mask & (1u << dir)) || k-- > 0; ++dir) {}
+        } // if
+
+        try {
+            if (location.getNeighbor(dir)->getEnemy()) pc.attackInDirection(DIRECTIONS[dir]);
+            else pc.makeMove(DIRECTIONS[dir]);
+        } catch (Enemy::AttackDodged &e) {
+        } catch (InvalidMove &e) {
+            // e.g. a dragon hoard still guarded: steps aside instead
+            for (int d = 0; d < NUM_DIRECTIONS; ++d) {
+                const Cell *neighbor = location.getNeighbor(d);
+                if (!neighbor || neighbor->isOccupiedByCharacter() || neighbor->containsItem()) continue;
+                pc.makeMove(DIRECTIONS[d]);
+                break;
+            } // for
+        } // catch
+    } // step()
+
+    /*******************************************************************************
+     * playScripted(options) plays a game on random boards, with a PC walking to
+     *  the stairs (see step()) and the floor printed every turn, and gets the
+     *  number of turns played
+     * notes: the PC is healed every turn
+     * time: O(NUM_FLOORS * MAX_TURNS_PER_FLOOR * time of a turn)
+     * *****************************************************************************/
+    int playScripted(const GameOptions &options) {
+        PC &pc = *createRace('s');
+        int turns = 0;
+        FlowField toStairs(0, 0);
+        try {
+            FloorBuilder builder(EMPTY_CONFIG, pc, options);
+            for (int floorNum = 1; floorNum <= NUM_FLOORS; ++floorNum) {
+                Floor *fl = builder.take(floorNum);
+                try {
+                    fl->enter();
+                    toStairs.resize(fl->getNumRows(), fl->getNumCols());
+                    toStairs.setSource(findStairs(*fl));
+                    for (int turn = 0; turn < MAX_TURNS_PER_FLOOR; ++turn) {
+                        step(pc, toStairs);
+                        ++turns;
+                        fl->turnEnemies();
+                        pc.turnFinished();
+                        pc.modifyHP(MAX_SPEED * 1000);
+                        nowhere << *fl;
+                    } // for
+                } catch (ReachedStairs &e) {
+                } catch (...) {
+                    builder.recycle(fl);
+                    throw;
+                } // catch
+                pc.clearDecorators();
+                builder.recycle(fl);
+            } // for
+        } catch (PCSlain &e) {
+        } // catch
+        delete &pc;
+        return turns;
+    } // playScripted()
+
+    // benchmarks building, printing and playing floors from config
+    void benchConfig(const string &config, const GameOptions &options) {
+        const string name = baseName(config);
+        const vector<string> rows = readRows(config);
+        if (rows.empty()) {
+            cerr << "Cannot read " << config << endl;
+            throw GameError();
+        } // if
+        measure("layout_parse/" + name, 1000, [&]() {
+            Layout layout(rows);
+            sink = sink + layout.getNumChambers();
+        });
+
+        PC *pc = createRace('s');
+        measure("floor_build/" + name, 200, [&]() {
+            Floor *fl = new Floor(1, config, *pc, options);
+            delete fl;
+        });
+        Floor fl(1, config, *pc, options);
+        measure("floor_reset/" + name, 200, [&]() {
+            fl.reset(1, config, *pc, options);
+        });
+
+        // the PC is healed every turn, and the floor rebuilt if it is slain anyway
+        GameOptions exact(options);
+        exact.exact = true;
+        const GameOptions *modes[] = {&options, &exact};
+        const string modeNames[] = {"turn_enemies/", "turn_enemies_exact/"};
+        for (int mode = 0; mode < 2; ++mode) {
+            Rng::current().seed(1);
+            fl.reset(1, config, *pc, *modes[mode]);
+            fl.enter();
+            int turn = 0;
+            measure(modeNames[mode] + name, 2000, [&]() {
+                try {
+                    fl.turnEnemies();
+                    pc->modifyHP(MAX_SPEED * 1000);
+                } catch (PCSlain &e) {
+                    delete pc;
+                    pc = createRace('s');
+                    fl.reset(1, config, *pc, *modes[mode]);
+                    fl.enter();
+                } // catch
+                // drops the PC's actions now and then
+                if (++turn % 256 == 0) nowhere << *pc;
+            });
+        } // for
+
+        measure("print_floor/" + name, 1000, [&]() {
+            nowhere << fl;
+        });
+        delete pc;
+    } // benchConfig()
+
+    // writes the results as JSON to out
+    void writeJson(ostream &out, const GameOptions &options) {
+        out << "{" << endl;
+        out << "  \"context\": {\"repetitions\": " << REPETITIONS << ", \"threads\": "
+            << options.threads << ", \"hard\": " << (options.hard ? "true" : "false")
+            << ", \"wake_radius\": " << options.wakeRadius << "}," << endl;
+        out << "  \"benchmarks\": [" << endl;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                << ", \"ns_per_op_min\": " << r.minNs << ", \"ns_per_op_median\": " << r.medianNs
+                << "}" << (i + 1 < results.size() ? "," : "") << endl;
+        } // for
+        out << "  ]" << endl;
+        out << "}" << endl;
+    } // writeJson()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    // separates switches (e.g. --hard) from configurations
+    GameOptions options;
+    options.threads = 1;
+    vector<string> configs;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) configs.push_back(arg);
+        else if (!parseOption(arg, options) || options.compat) {
+            cerr << "Invalid option: " << arg << endl;
+            return 1;
+        } // else if
+    } // for
+
+    // the game prints as it goes, which is not what is measured
+    streambuf *const console = cout.rdbuf(&nullBuffer);
+    try {
+        for (vector<string>::const_iterator it = configs.begin(); it != configs.end(); ++it) {
+            benchConfig(*it, options);
+        } // for
+
+        int seed = 0;
+        measure("layout_generate", 1000, [&]() {
+            Layout layout(Generator(++seed).generate(NUM_ROWS, NUM_COLS));
+            sink = sink + layout.getNumChambers();
+        });
+        Rng::current().seed(1);
+        PC *pc = createRace('s');
+        Floor fl(1, EMPTY_CONFIG, *pc, options);
+        measure("floor_random", 200, [&]() {
+            fl.reset(1, EMPTY_CONFIG, *pc, options);
+        });
+        delete pc;
+
+        // potions stack up as a linked list of decorators
+        const int depths[] = {1, 16, 256};
+        for (int d = 0; d < 3; ++d) {
+            pc = createRace('s');
+            for (int i = 0; i < depths[d]; ++i) {
+                if (i % 2) pc->attachDecorator(*new BoostAttack(pc->getDecorators(), 1));
+                else pc->attachDecorator(*new WoundAttack(pc->getDecorators(), 1));
+            } // for
+            ostringstream name;
+            name << "get_atk/" << depths[d];
+            measure(name.str(), 4096 / depths[d] * 64, [&]() {
+                sink = sink + pc->getAtk();
+            });
+            delete pc;
+        } // for
+
+        int games = 0, turns = 0;
+        measure("game", 5, [&]() {
+            Rng::current().seed(GAME_SEED);
+            turns += playScripted(options);
+            ++games;
+        });
+        cerr << "game: " << turns / games << " turns (seed " << GAME_SEED << ")" << endl;
+    } catch (GameException &e) {
+        cout.rdbuf(console);
+        cerr << "Benchmark failed" << endl;
+        return 1;
+    } // catch
+    cout.rdbuf(console);
+
+    writeJson(cout, options);
+    return 0;
+} // main()
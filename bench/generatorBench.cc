@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * generatorBench.cc
+ * 
+ * Benchmark measuring how many floor layouts can be generated per second.
+ * 
+ * Usage: ./generatorBench [count [rows cols]]
+ * ****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include "generator.h"
+#include "layout.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+int main(int argc, char *argv[]) {
+    int count = 100000, numRows = NUM_ROWS, numCols = NUM_COLS;
+    if (argc > 1) istringstream(argv[1]) >> count;
+    if (argc > 3) {
+        istringstream(argv[2]) >> numRows;
+        istringstream(argv[3]) >> numCols;
+    } // if
+
+    // generates the layouts and labels their chambers, as a new floor would
+    long long numChambers = 0;
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        Layout layout(Generator(i + 1).generate(numRows, numCols));
+        numChambers += layout.getNumChambers();
+    } // for
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "generated " << count << " layouts of " << numRows << "x" << numCols 
+         << " in " << seconds << " s" << endl;
+    cout << count / seconds << " layouts/s, " << seconds * 1e6 / count << " us/layout, "
+         << (double) numChambers / count << " chambers/layout" << endl;
+    return 0;
+} // main()
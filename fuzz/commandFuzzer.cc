@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * commandFuzzer.cc
+ *
+ * Fuzz target for the commands of a session: the first line of every input
+ * picks a configuration, a seed and options, as a line of the golden test
+ * manifest does (e.g. "full 101 --compat"), and the rest is fed to playGames()
+ * as the player's commands, all in this process and without printing anything.
+ *
+ * Only the configurations in configurations/ (by name) and "empty" (the empty
+ * configuration) can be picked, and only the options that change how the game
+ * is played (--compat, --hard, --exact and --radius=N); other inputs are
+ * skipped. A session is expected to end normally or on a GameException;
+ * anything else (a crash, a sanitizer report, another exception) is a bug.
+ *
+ * Usage: see fuzzMain.cc (or link with libFuzzer), from the root of the
+ *        repository
+ * ****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "game.h"
+#include "console.h"
+#include "rng.h"
+#include "constants.h"
+
+using namespace std;
+
+namespace {
+    // configurations that may be picked
+    const int NUM_CONFIGS = 7;
+    const char *CONFIGS[NUM_CONFIGS] =
+        {"fiveFloors", "floorConfig", "full", "merchantMania", "oneEnemy", "random", "surrounded"};
+
+    // stream that prints nothing (it has no buffer, so nothing is formatted)
+    ostream nowhere(NULL);
+
+    // gets the file of the configuration called name (empty if it may not be picked)
+    string configFile(const string &name) {
+        if (name == "empty") return constants::EMPTY_CONFIG;
+        for (int i = 0; i < NUM_CONFIGS; ++i) {
+            if (name == CONFIGS[i]) return "configurations/" + name + ".txt";
+        } // for
+        return "";
+    } // configFile()
+
+    // updates options according to the switch in arg (false if it may not be used)
+    bool parseGameOption(const string &arg, GameOptions &options) {
+        if (arg != "--compat" && arg != "--hard" && arg != "--exact"
+            && arg.compare(0, 9, "--radius=") != 0) return false;
+        return parseOption(arg, options);
+    } // parseGameOption()
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, const size_t size) {
+    const string input((const char *) data, size);
+    const size_t newline = input.find('\n');
+    if (newline == string::npos) return 0;
+
+    // reads the header
+    istringstream header(input.substr(0, newline));
+    string name, arg;
+    unsigned int seed;
+    if (!(header >> name >> seed)) return 0;
+    const string filename = configFile(name);
+    if (filename.empty()) return 0;
+    GameOptions options;
+    options.threads = 1;
+    while (header >> arg) {
+        if (!parseGameOption(arg, options)) return 0;
+    } // while
+
+    // plays the commands
+    istringstream commands(input.substr(newline + 1));
+    Console::use(&commands, &nowhere);
+    Rng::current().seed(seed);
+    try {
+        playGames(filename, options);
+    } catch (GameException &e) {
+    } // catch
+    Console::use(NULL, NULL);
+    return 0;
+} // LLVMFuzzerTestOneInput()
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * configFuzzer.cc
+ *
+ * Fuzz target for the floor configurations: every input is read as a
+ * configuration file (compiled, if it starts as one does), built into a floor
+ * (in the mode picked by the parity of its size), entered, and played for a
+ * few turns of the enemies, all in this process and without printing anything.
+ *
+ * Invalid configurations are expected to be rejected with a GameException;
+ * anything else (a crash, a sanitizer report, another exception) is a bug.
+ *
+ * Usage: see fuzzMain.cc (or link with libFuzzer)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "game.h"
+#include "floor.h"
+#include "layout.h"
+#include "pc.h"
+#include "arena.h"
+#include "console.h"
+
+using namespace std;
+
+namespace {
+    // name the input is defined under (see Layout::define())
+    const string CONFIG_NAME = "fuzz input";
+
+    // turns the enemies take on every floor
+    const int NUM_TURNS = 4;
+
+    // stream that prints nothing (it has no buffer, so nothing is formatted)
+    ostream nowhere(NULL);
+
+    // silences the game, once
+    bool silence() {
+        Console::use(NULL, &nowhere);
+        cerr.rdbuf(NULL);
+        return true;
+    } // silence()
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, const size_t size) {
+    static const bool silenced = silence();
+    (void) silenced;
+
+    try {
+        Layout::define(CONFIG_NAME, string((const char *) data, size));
+    } catch (GameException &e) {
+        return 0;
+    } // catch
+
+    GameOptions options;
+    options.compat = size % 2;
+    options.threads = 1;
+    PC *pc = createRace('s');
+    Floor *fl = NULL;
+    try {
+        fl = new Floor(1, CONFIG_NAME, *pc, options);
+        fl->enter();
+        Console::out() << *fl;
+        for (int turn = 0; turn < NUM_TURNS; ++turn) {
+            fl->turnEnemies();
+            pc->turnFinished();
+        } // for
+    } catch (GameException &e) {
+    } // catch
+    delete fl;
+    delete pc;
+    Arena::use(NULL);
+    return 0;
+} // LLVMFuzzerTestOneInput()
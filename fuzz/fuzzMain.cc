@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * fuzzMain.cc
+ *
+ * Stand-alone driver for the fuzz targets, for compilers without libFuzzer
+ * (with clang, link the targets with -fsanitize=fuzzer instead). It runs the
+ * target on every file of the corpus given, then on -runs=N random mutations
+ * of them (bits flipped, bytes replaced, inserted and erased, pieces of inputs
+ * copied and spliced), and reports the executions per second.
+ *
+ * Build the targets with sanitizers (see the Makefile): when one reports an
+ * error, or the target throws, the input being run is written to
+ * crash-<number> so that it can be replayed by passing it as the corpus.
+ *
+ * Usage: ./<target> [-runs=N] [-seed=S] [-max_len=N] file_or_directory ...
+ * ****************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <exception>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <dirent.h>
+#include "rng.h"
+
+using namespace std;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, const size_t size);
+
+// lets the sanitizers report which input failed (if linked with them)
+extern "C" void __sanitizer_set_death_callback(void (*callback)()) __attribute__((weak));
+
+namespace {
+    // input being run (for the crash report)
+    const string *running = NULL;
+
+    // most mutations applied to an input at once
+    const int MAX_MUTATIONS = 4;
+
+    // writes the input being run to a file, and says so
+    void saveRunning() {
+        if (!running) return;
+        ostringstream name;
+        name << "crash-" << hash<string>()(*running);
+        ofstream out(name.str().c_str(), ios::binary);
+        out << *running;
+        cerr << "Input written to " << name.str() << endl;
+    } // saveRunning()
+
+    // reports an exception escaping the target
+    void terminated() {
+        cerr << "The target threw an exception." << endl;
+        saveRunning();
+        abort();
+    } // terminated()
+
+    // adds the contents of path (a file or a directory of files) to corpus
+    void readCorpus(const string &path, vector<string> &corpus) {
+        if (DIR *dir = opendir(path.c_str())) {
+            while (dirent *entry = readdir(dir)) {
+                const string name = entry->d_name;
+                if (name != "." && name != "..") readCorpus(path + "/" + name, corpus);
+            } // while
+            closedir(dir);
+            return;
+        } // if
+        ifstream in(path.c_str(), ios::binary);
+        if (!in.good()) {
+            cerr << "Cannot read " << path << endl;
+            return;
+        } // if
+        ostringstream contents;
+        contents << in.rdbuf();
+        corpus.push_back(contents.str());
+    } // readCorpus()
+
+    // runs the target on input
+    void run(const string &input) {
+        running = &input;
+        LLVMFuzzerTestOneInput((const uint8_t *) input.data(), input.size());
+        running = NULL;
+    } // run()
+
+    // draws a number in [0, n)
+    size_t draw(Rng &rng, const size_t n) {
+        const size_t high = rng.next();
+        return ((high << 15) ^ rng.next()) % n;
+    } // draw()
+
+    /*******************************************************************************
+     * mutate(input, corpus, maxLength, rng) applies a few random mutations to
+     *  input, drawing bytes and pieces from the corpus, keeping it at most
+     *  maxLength long
+     * required: corpus is not empty
+     * time: O(maxLength)
+     * *****************************************************************************/
+    void mutate(string &input, const vector<string> &corpus, const size_t maxLength, Rng &rng) {
+        const int numMutations = 1 + draw(rng, MAX_MUTATIONS);
+        for (int i = 0; i < numMutations; ++i) {
+            const string &other = corpus[draw(rng, corpus.size())];
+            const char byte = other.empty() ? (char) draw(rng, 256) : other[draw(rng, other.size())];
+            switch (draw(rng, 6)) {
+                case 0:
+                    // flips a bit
+                    if (!input.empty()) input[draw(rng, input.size())] ^= 1 << draw(rng, 8);
+                    break;
+                case 1:
+                    // replaces a byte
+                    if (!input.empty()) input[draw(rng, input.size())] = byte;
+                    break;
+                case 2:
+                    // inserts a byte
+                    input.insert(input.begin() + draw(rng, input.size() + 1), byte);
+                    break;
+                case 3:
+                    // erases a few bytes
+                    if (!input.empty()) {
+                        const size_t at = draw(rng, input.size());
+                        input.erase(at, 1 + draw(rng, min(input.size() - at, (size_t) 8)));
+                    } // if
+                    break;
+                case 4: {
+                    // copies a piece of another input in
+                    if (other.empty()) break;
+                    const size_t from = draw(rng, other.size());
+                    const size_t length = 1 + draw(rng, min(other.size() - from, (size_t) 64));
+                    input.insert(draw(rng, input.size() + 1), other, from, length);
+                    break;
+                } default: {
+                    // keeps the start of the input and the end of another
+                    const size_t at = draw(rng, input.size() + 1);
+                    input = input.substr(0, at) + other.substr(min(at, other.size()));
+                } // default
+            } // switch
+        } // for
+        if (input.size() > maxLength) input.resize(maxLength);
+    } // mutate()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    long runs = 0;
+    unsigned int seed = 1;
+    size_t maxLength = 4096;
+    vector<string> corpus;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg.compare(0, 6, "-runs=") == 0) runs = atol(arg.c_str() + 6);
+        else if (arg.compare(0, 6, "-seed=") == 0) seed = atol(arg.c_str() + 6);
+        else if (arg.compare(0, 9, "-max_len=") == 0) maxLength = atol(arg.c_str() + 9);
+        else if (arg[0] == '-') cerr << "Ignored flag: " << arg << endl;
+        else readCorpus(arg, corpus);
+    } // for
+
+    set_terminate(terminated);
+    if (__sanitizer_set_death_callback) __sanitizer_set_death_callback(saveRunning);
+
+    // runs the corpus, then mutations of it
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (vector<string>::const_iterator it = corpus.begin(); it != corpus.end(); ++it) run(*it);
+    const long total = corpus.size() + runs;
+    if (corpus.empty()) corpus.push_back("");
+    Rng rng(seed);
+    for (long i = 0; i < runs; ++i) {
+        string input = corpus[draw(rng, corpus.size())];
+        mutate(input, corpus, maxLength, rng);
+        run(input);
+    } // for
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Done " << total << " runs in " << seconds << " s (" << (long) (total / seconds)
+         << " exec/s)" << endl;
+    return 0;
+} // main()
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * arena.cc
+ * 
+ * Module implementing the arenas holding the objects that live as long as a 
+ * floor.
+ * ****************************************************************************/
+
+#include <new>
+#include <cassert>
+#include "arena.h"
+
+using namespace std;
+
+namespace {
+    // every allocation is rounded up to a multiple of ALIGNMENT
+    const size_t ALIGNMENT = 16;
+
+    // every thread's own arena, and the arena it currently allocates from
+    thread_local Arena ownArena;
+    thread_local Arena *currentArena = 0;
+} // namespace
+
+const size_t Arena::BLOCK_SIZE;
+
+// constructor
+Arena::Arena() : currentBlock(0), used(0) {}
+
+// destructor
+Arena::~Arena() {
+    for (vector<char *>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        ::operator delete(*it);
+    } // for
+} // Arena dtor
+
+// see arena.h for details
+void* Arena::allocate(const size_t size) {
+    assert(size <= BLOCK_SIZE);
+    const size_t rounded = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    // moves on to the next block (taking one from the heap if there is none)
+    // when the current one is full
+    if (blocks.empty() || used + rounded > BLOCK_SIZE) {
+        if (!blocks.empty()) ++currentBlock;
+        if (currentBlock == blocks.size()) {
+            blocks.push_back(static_cast<char *>(::operator new(BLOCK_SIZE)));
+        } // if
+        used = 0;
+    } // if
+    void *p = blocks[currentBlock] + used;
+    used += rounded;
+    return p;
+} // allocate()
+
+// see arena.h for details
+void Arena::release() {
+    currentBlock = 0;
+    used = 0;
+} // release()
+
+// see arena.h for details
+Arena& Arena::current() {
+    return currentArena ? *currentArena : ownArena;
+} // current()
+
+// see arena.h for details
+void Arena::use(Arena *a) {
+    currentArena = a;
+} // use()
@@ -0,0 +1,72 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <cstddef>
+#include <vector>
+
+class Arena {
+    // storage, taken from the heap BLOCK_SIZE bytes at a time and kept until
+    // the arena is destroyed
+    std::vector<char *> blocks;
+
+    // block being filled, and bytes of it already handed out
+    std::size_t currentBlock;
+    std::size_t used;
+
+    // arenas cannot be copied
+    Arena(const Arena &other);
+    Arena& operator= (const Arena &other);
+
+  public:
+    // largest allocation, and size of the blocks of storage
+    static const std::size_t BLOCK_SIZE = 4096;
+
+    /*******************************************************************************
+     * Arena constructor creates an empty arena
+     * time: O(1)
+     * *****************************************************************************/
+    Arena();
+
+    /*******************************************************************************
+     * Arena destructor returns the storage of the arena to the heap
+     * notes: does not destroy the objects allocated from it
+     * time: O(#blocks)
+     * *****************************************************************************/
+    ~Arena();
+
+    /*******************************************************************************
+     * allocate(size) gets storage for an object of size bytes, suitably aligned
+     *  for any type
+     * notes: the storage cannot be released on its own; it is released along
+     *        with everything else in the arena (see release())
+     * required: size <= BLOCK_SIZE
+     * time: O(1) amortized
+     * *****************************************************************************/
+    void* allocate(const std::size_t size);
+
+    /*******************************************************************************
+     * release() makes all the storage of the arena available again, at once
+     * notes: the objects allocated from the arena are not destroyed, so they
+     *        may not own anything outside the arena
+     *        the storage is kept, so refilling the arena as much allocates nothing
+     * time: O(1)
+     * *****************************************************************************/
+    void release();
+
+    /*******************************************************************************
+     * current() gets the arena the calling thread allocates from
+     * notes: each thread starts with its own arena, which is never released
+     * time: O(1)
+     * *****************************************************************************/
+    static Arena& current();
+
+    /*******************************************************************************
+     * use(a) makes the calling thread allocate from a (or from its own arena if
+     *  a is NULL)
+     * required: a outlives its use
+     * time: O(1)
+     * *****************************************************************************/
+    static void use(Arena *a);
+};
+
+#endif
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * bitboard.cc
+ * 
+ * Module implementing a board of bits, one per cell, packed in 64-bit words.
+ * ****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include "bitboard.h"
+
+using namespace std;
+
+namespace {
+    // number of bits per word
+    const int WORD_BITS = 64;
+
+    // number of set bits in w
+    int popCount(uint64_t w) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(w);
+#else
+        int count = 0;
+        for (; w; w &= w - 1) ++count;
+        return count;
+#endif
+    } // popCount()
+
+    // position of the lowest set bit of w
+    // required: w != 0
+    int lowestBit(uint64_t w) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(w);
+#else
+        int bit = 0;
+        for (; !(w & 1); w >>= 1) ++bit;
+        return bit;
+#endif
+    } // lowestBit()
+} // namespace
+
+// constructor
+Bitboard::Bitboard(const int numRows, const int numCols) : 
+    numRows(numRows), numCols(numCols), stride(numCols + 1),
+    words((numRows * (numCols + 1) + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+// see bitboard.h for details
+void Bitboard::set(const int row, const int col) {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    const int i = row * stride + col;
+    words[i / WORD_BITS] |= (uint64_t) 1 << (i % WORD_BITS);
+} // set()
+
+// see bitboard.h for details
+void Bitboard::reset(const int row, const int col) {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    const int i = row * stride + col;
+    words[i / WORD_BITS] &= ~((uint64_t) 1 << (i % WORD_BITS));
+} // reset()
+
+// see bitboard.h for details
+bool Bitboard::test(const int row, const int col) const {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    const int i = row * stride + col;
+    return (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+} // test()
+
+// see bitboard.h for details
+void Bitboard::clear() {
+    for (size_t w = 0; w < words.size(); ++w) words[w] = 0;
+} // clear()
+
+// see bitboard.h for details
+int Bitboard::count() const {
+    int total = 0;
+    for (size_t w = 0; w < words.size(); ++w) total += popCount(words[w]);
+    return total;
+} // count()
+
+// see bitboard.h for details
+void Bitboard::resize(const int numRows, const int numCols) {
+    this->numRows = numRows;
+    this->numCols = numCols;
+    stride = numCols + 1;
+    words.assign((numRows * (numCols + 1) + WORD_BITS - 1) / WORD_BITS, 0);
+} // resize()
+
+// see bitboard.h for details
+bool Bitboard::first(int &row, int &col) const {
+    for (size_t w = 0; w < words.size(); ++w) {
+        if (!words[w]) continue;
+        const int bit = w * WORD_BITS + lowestBit(words[w]);
+        row = bit / stride;
+        col = bit % stride;
+        return true;
+    } // for
+    return false;
+} // first()
+
+// see bitboard.h for details
+bool Bitboard::next(int &row, int &col) const {
+    const int start = row * stride + col + 1;
+    size_t w = start / WORD_BITS;
+    if (w >= words.size()) return false;
+    uint64_t word = words[w] & (~(uint64_t) 0 << (start % WORD_BITS));
+    while (!word) {
+        if (++w == words.size()) return false;
+        word = words[w];
+    } // while
+    const int bit = w * WORD_BITS + lowestBit(word);
+    row = bit / stride;
+    col = bit % stride;
+    return true;
+} // next()
+
+// see bitboard.h for details
+bool Bitboard::anyInNeighborhood(const int row, const int col) const {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    // (col - 1) may be -1, which is the guard bit of the previous row
+    const uint64_t window = 7;
+    for (int r = max(row - 1, 0); r <= row + 1 && r < numRows; ++r) {
+        const int first = r * stride + col - 1;
+        if (first < 0) {
+            if (words[0] & (window >> 1)) return true;
+            continue;
+        } // if
+        const int w = first / WORD_BITS, offset = first % WORD_BITS;
+        uint64_t bits = words[w] >> offset;
+        if (offset > WORD_BITS - 3 && w + 1 < (int) words.size()) {
+            bits |= words[w + 1] << (WORD_BITS - offset);
+        } // if
+        if (bits & window) return true;
+    } // for
+    return false;
+} // anyInNeighborhood()
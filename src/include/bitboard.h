@@ -0,0 +1,77 @@
+#ifndef __BITBOARD_H__
+#define __BITBOARD_H__
+
+#include <vector>
+#include <stdint.h>
+
+class Bitboard {
+    // dimensions of the board
+    int numRows, numCols;
+
+    // bits per row: one more than numCols, so that the last bit of every row
+    // is a guard that is always cleared, and the bits on either side of any
+    // column can be read without checking for the edge of the row
+    int stride;
+
+    // bit (row, col) is bit (row * stride + col) % 64 of word (row * stride + col) / 64
+    std::vector<uint64_t> words;
+
+  public:
+    /*******************************************************************************
+     * Bitboard constructor creates an empty board of numRows x numCols bits
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    Bitboard(const int numRows, const int numCols);
+
+    /*******************************************************************************
+     * set(row, col), reset(row, col), test(row, col) set, clear and get the bit 
+     *  for (row, col)
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(1)
+     * *****************************************************************************/
+    void set(const int row, const int col);
+    void reset(const int row, const int col);
+    bool test(const int row, const int col) const;
+
+    // clears every bit
+    void clear();
+
+    /*******************************************************************************
+     * resize(numRows, numCols) makes this an empty board of numRows x numCols bits
+     * notes: reuses the storage of the board
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    void resize(const int numRows, const int numCols);
+
+    /*******************************************************************************
+     * count() gets the number of set bits
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    int count() const;
+
+    /*******************************************************************************
+     * first(row, col) stores in row, col the first set bit (in reading order)
+     * notes: returns false (leaving row, col alone) if no bit is set
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    bool first(int &row, int &col) const;
+
+    /*******************************************************************************
+     * next(row, col) stores in row, col the first set bit after (row, col) (in
+     *  reading order)
+     * notes: returns false (leaving row, col alone) if no bit after it is set
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    bool next(int &row, int &col) const;
+
+    /*******************************************************************************
+     * anyInNeighborhood(row, col) determines if any bit is set in the 3x3 square 
+     *  centered at (row, col)
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(1)
+     * *****************************************************************************/
+    bool anyInNeighborhood(const int row, const int col) const;
+};
+
+#endif
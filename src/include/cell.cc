@@ -15,6 +15,23 @@ using namespace std;
 // see cell.h for details
 Cell::Cell (const int row, const int col, const int chamberNum, const char ch, PC &pc, Floor &fl): 
             row(row), col(col), chamberNum(chamberNum), ch(ch), fl(fl), item (0), pc(0), enemy(0) {
+    init(ch, pc);
+} // Cell ctor
+
+// see cell.h for details
+void Cell::reset(const int chamberNum, const char ch, PC &pc) {
+    item = NULL;
+    this->pc = NULL;
+    enemy = NULL;
+    this->chamberNum = chamberNum;
+    this->ch = ch;
+    init(ch, pc);
+} // reset()
+
+// see cell.h for details
+void Cell::init(const char ch, PC &pc) {
+    for (int i = 0; i < constants::NUM_DIRECTIONS; ++i) neighbors[i] = NULL;
+
     if (ch == '.') type = FloorTile;
     else if (ch == '@') {
         type = FloorTile;
@@ -105,29 +122,48 @@ Cell::Cell (const int row, const int col, const int chamberNum, const char ch, P
         cerr << "Invalid board character: " + string(1,ch) << endl;
         throw GameError();
     } // else
-} // Cell ctor
+    fl.cellChanged(*this);
+} // init()
 
 // see cell.h for details
-Cell::~Cell(){
-    delete item;
-} // ~Cell()
-
-// see cell.h for details
-void Cell::addNeighbor(const string dir, Cell &neighbor) {
-    neighbors.insert(pair<const string, Cell &>(dir, neighbor));
+void Cell::addNeighbor(const int dir, Cell &neighbor) {
+    assert(0 <= dir && dir < constants::NUM_DIRECTIONS);
+    neighbors[dir] = &neighbor;
 } // addNeighbor()
 
 // see cell.h for details
 Cell* Cell::getNeighbor(const string dir) const{
-    map<string, Cell &>::const_iterator it = neighbors.find(dir);
-    return (it == neighbors.end()) ? 0 : &(it->second);
-} // getNeighbor()
+    const int index = constants::getDirectionIndex(dir);
+    return (index == -1) ? 0 : neighbors[index];
+} // getNeighbor(string)
+
+// see cell.h for details
+Cell* Cell::getNeighbor(const int dir) const{
+    assert(0 <= dir && dir < constants::NUM_DIRECTIONS);
+    return neighbors[dir];
+} // getNeighbor(int)
+
+// see cell.h for details
+unsigned int Cell::enemyMoveMask() const {
+    unsigned int mask = 0;
+    for (int i = 0; i < constants::NUM_DIRECTIONS; ++i) {
+        const Cell *target = neighbors[i];
+        if (target && target->type == FloorTile && !target->item
+            && !target->pc && !target->enemy) {
+            mask |= 1u << i;
+        } // if
+    } // for
+    return mask;
+} // enemyMoveMask()
 
 // see cell.h for details
 Dragon& Cell::generateDragon (DragonHoard &dh) const {
-    // tries every walkable neighbor
-    for (std::map<std::string, Cell &>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
-        Cell &target = (*it).second;
+    // tries every walkable neighbor, in alphabetical order of direction
+    for (map<const string, pair<const int, const int> >::const_iterator 
+            it = constants::DIRECTION_TO_OFFSET.begin(); it != constants::DIRECTION_TO_OFFSET.end(); ++it) {
+        Cell *neighbor = getNeighbor(it->first);
+        if (!neighbor) continue;
+        Cell &target = *neighbor;
         if (target.isFloorTile() && !target.isStairs()
             && !target.containsItem() && !target.isOccupiedByCharacter()) {
             // if target is empty and is a floor tile, creates a dragon in it
@@ -166,9 +202,20 @@ int Cell::getChamberNum() const {
     return chamberNum;
 } //getChamberNum()
 
+// see cell.h for details
+int Cell::getRow() const {
+    return row;
+} // getRow()
+
+// see cell.h for details
+int Cell::getCol() const {
+    return col;
+} // getCol()
+
 // see cell.h for details
 void Cell::setStairs(){
     type = Cell::Stairs;
+    fl.cellChanged(*this);
 } // setStairs()
 
 // see cell.h for details
@@ -178,7 +225,8 @@ void Cell::characterMovesIn(PC &p) {
         throw GameError();
     } // if
     pc = &p;
-    p.setLocation(this);
+    if (fl.isEntered()) p.setLocation(this);
+    fl.cellChanged(*this);
 } // characterMovesIn(PC&)
 
 // see cell.h for details
@@ -189,6 +237,7 @@ void Cell::characterMovesIn(Enemy &e) {
     } // if
     enemy = &e;
     e.setLocation(this);
+    fl.cellChanged(*this);
 } // characterMovesIn(Enemy&)
 
 // see cell.h for details
@@ -196,6 +245,7 @@ void Cell::pcMovesOut() {
     assert(pc);
     pc->setLocation(NULL);
     pc = NULL;
+    fl.cellChanged(*this);
 } // pcMovesOut()
 
 // see cell.h for details
@@ -203,6 +253,7 @@ void Cell::enemyMovesOut() {
     assert(enemy);
     enemy->setLocation(NULL);
     enemy = NULL;
+    fl.cellChanged(*this);
 } // enemyMovesOut()
 
 // see cell.h for details
@@ -211,6 +262,7 @@ void Cell::enemyDies() {
     fl.removeEnemy(*enemy);
     delete enemy;
     enemy = NULL;
+    fl.cellChanged(*this);
 } // enemyDies()
 
 // see cell.h for details
@@ -250,6 +302,7 @@ void Cell::depositItem (Item &i) {
         throw GameError();
     } // if
     item = &i;
+    fl.cellChanged(*this);
 } // depositItem()
 
 // see cell.h for details
@@ -258,18 +311,21 @@ void Cell::pickUpItem(Player &p){
     item->pickUp(p);
 
     // removes item
-    delete item;
     item = NULL;
     ch = '.';
+    fl.cellChanged(*this);
 } // pickUpItem
 
 // see cell.h for details
-ostream& operator<< (ostream& out, const Cell &c) {
-    if (c.type == Cell::Stairs) out << "\\";
-    else if (c.containsItem()) out << c.item->getToken();
-    else if (c.isOccupiedByPC()) out << c.pc->getToken();
-    else if (c.isOccupiedByCharacter()) out << c.enemy->getToken();
-    else out << c.ch;
+char Cell::getToken() const {
+    if (type == Stairs) return '\\';
+    else if (containsItem()) return item->getToken();
+    else if (isOccupiedByPC()) return pc->getToken();
+    else if (isOccupiedByCharacter()) return enemy->getToken();
+    else return ch;
+} // getToken()
 
-    return out;
+// see cell.h for details
+ostream& operator<< (ostream& out, const Cell &c) {
+    return out << c.getToken();
 } // operator<< (ostream&, Cell&)
@@ -1,8 +1,8 @@
 #ifndef __CELL_H__
 #define __CELL_H__
 
-#include <map>
 #include <iostream>
+#include "constants.h"
 #include "floor.h"
 #include "game.h"
 #include "pc.h"
@@ -17,7 +17,7 @@ class Cell {
     const int col;
 
     // chamber number if this is a floor tile; -1 for non-floor tiles
-    const int chamberNum;
+    int chamberNum;
     
     // character representation
     char ch;
@@ -25,8 +25,9 @@ class Cell {
     enum TileType {FloorTile, Doorway, Passageway, Wall, Stairs, Empty, NUM_TILE_TYPES};
     TileType type;
 
-    // (direction, Cell) pairs for cells in 1 block radius
-    std::map<std::string, Cell &> neighbors;
+    // walkable cells in 1 block radius, indexed in the order of DIRECTIONS
+    // (NULL if the neighbor in that direction is not walkable)
+    Cell *neighbors[constants::NUM_DIRECTIONS];
 
     // floor containing the cell
     Floor &fl;
@@ -36,6 +37,13 @@ class Cell {
     PC *pc;
     Enemy *enemy;
 
+    /*******************************************************************************
+     * init(ch, pc) sets up the cell for configuration character ch
+     * notes: see Cell constructor
+     * time: O(1)
+     * *****************************************************************************/
+    void init(const char ch, PC &pc);
+
   public:   
 
     /*******************************************************************************
@@ -43,7 +51,8 @@ class Cell {
      * required: ch is one of '.','\','|','-','+','#','0'-'9'(gold/potion),
      *           '@' (PC), 'H' 'D' 'E' 'O' 'W' 'L' 'M' (enemy)
      * effects: creates enemies/items as needed
-     *          enemies must be freed by caller; items will be freed by cell dtor
+     *          enemies must be freed by caller; items are allocated from the 
+     *          current arena (see Item), and are not freed by the cell
      *          if enemy, stores in fl.enemies
      *          if dragon, stores in fl.dragons
      *          if '@', moves pc to this cell 
@@ -52,23 +61,44 @@ class Cell {
     Cell (const int row, const int col, const int chamberNum, const char ch, PC& pc, Floor &fl);
 
     /*******************************************************************************
-     * Cell destructor
-     * effects: frees memory for any item it contains
-     * time : O(1)
+     * reset(chamberNum, ch, pc) makes this the cell the constructor would create
+     *  for chamberNum, ch, pc (at the same coordinates, on the same floor)
+     * notes: forgets any item in the cell (its storage goes with the floor's 
+     *        arena); its enemy, if any, must have been freed already
+     *        the cell has no neighbors until they are added again
+     * time: O(1)
      * *****************************************************************************/
-    ~Cell();
+    void reset(const int chamberNum, const char ch, PC &pc);
 
     /*******************************************************************************
-     * addNeighbor(dir, neighbor) adds pair (dir, neighbor) to list of neighbors 
+     * addNeighbor(dir, neighbor) stores neighbor as the walkable cell in direction
+     *  DIRECTIONS[dir]
+     * required: 0 <= dir < NUM_DIRECTIONS
      * *****************************************************************************/
-    void addNeighbor(const std::string dir, Cell &neighbor);
+    void addNeighbor(const int dir, Cell &neighbor);
 
     /*******************************************************************************
      * getter for walkable neighbor in direction dir
      * notes: returns NULL if no walkable neighbor in that direction
-     * time : O(#neighbors)
+     * time : O(NUM_DIRECTIONS)
      * *****************************************************************************/
-    Cell* getNeighbor(std::string dir) const;
+    Cell* getNeighbor(const std::string dir) const;
+
+    /*******************************************************************************
+     * getter for walkable neighbor in direction DIRECTIONS[dir]
+     * required: 0 <= dir < NUM_DIRECTIONS
+     * notes: returns NULL if no walkable neighbor in that direction
+     * time : O(1)
+     * *****************************************************************************/
+    Cell* getNeighbor(const int dir) const;
+
+    /*******************************************************************************
+     * enemyMoveMask() computes the directions an enemy in this cell may move in
+     * notes: bit i is set iff the neighbor in direction DIRECTIONS[i] is a floor
+     *        tile that contains no item and no character
+     * time : O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    unsigned int enemyMoveMask() const;
 
     /*******************************************************************************
      * generateDragon (dh) creates a dragon in 1 block radius of dh
@@ -93,13 +123,20 @@ class Cell {
     // getter for chamberNum
     int getChamberNum() const;
 
+    // getter for row
+    int getRow() const;
+
+    // getter for col
+    int getCol() const;
+
     // sets this cell as stairs
     void setStairs();
 
     /*******************************************************************************
      * characterMovesIn(p) moves PC p to this cell
      * required: cell must be currently unoccupied by characters
-     * effects: stores p in this cell and updates location of p
+     * effects: stores p in this cell and updates location of p (the location
+     *          is only updated once the floor is entered; see Floor::enter())
      * *****************************************************************************/
     void characterMovesIn(PC &p);
 
@@ -163,17 +200,23 @@ class Cell {
      * pickUpItem(p) has p pick up the item in this cell
      * required: this cell contains an item
      * effects: modifies p according to the item's type
-     *          deletes the item in this cell
+     *          removes the item from this cell
      * exceptions: throws DragonAlive() if item is a dragon
      *             hoard whose dragon is still alive
      * time: O(1)
      * *****************************************************************************/
     void pickUpItem(Player &p);
 
+    /*******************************************************************************
+     * getToken() gets the token printed for this cell based on its type and 
+     *  its occupant (PC/enemy/item)
+     * time : O(1)
+     * *****************************************************************************/
+    char getToken() const;
+
     /*******************************************************************************
      * << overload
-     * effects: prints token for this cell based on its type and 
-     *          its occupant (PC/enemy/item)
+     * effects: prints token for this cell (see getToken())
      * time : O(1)
      * *****************************************************************************/
     friend std::ostream& operator<< (std::ostream& out, const Cell &c);
@@ -0,0 +1,476 @@
+/*******************************************************************************
+ * console.cc
+ *
+ * Module implementing the streams the game reads commands from and prints to.
+ * ****************************************************************************/
+
+#include <vector>
+#include <string>
+#include <streambuf>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "console.h"
+
+using namespace std;
+
+namespace {
+    // most bytes of the input read at once
+    const size_t CHUNK = 1 << 16;
+
+    // determines if ch is whitespace (as the classic locale has it)
+    bool isSpace(const char ch) {
+        return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+    } // isSpace()
+
+    // columns between tab stops
+    const int TAB_WIDTH = 8;
+
+    // rows of the screen when the terminal does not tell
+    const int DEFAULT_ROWS = 50;
+
+    // writes text to the standard output, whole
+    void writeAll(const string &text) {
+        size_t written = 0;
+        while (written < text.size()) {
+            const ssize_t n = ::write(STDOUT_FILENO, text.data() + written, text.size() - written);
+            if (n > 0) written += n;
+            else if (n == -1 && errno != EINTR) return;
+        } // while
+    } // writeAll()
+
+    // appends the escape sequence moving the cursor to (row, col) (from 0) to out
+    void moveTo(string &out, const int row, const int col) {
+        out += "\x1b[" + to_string(row + 1) + ";" + to_string(col + 1) + "H";
+    } // moveTo()
+
+    /*******************************************************************************
+     * Screen prints to a terminal in raw mode, redrawing only the characters 
+     * that changed: what is printed is kept until the input is read (the 
+     * frame), then drawn over what the terminal shows (see 
+     * Console::useRawTerminal())
+     * *****************************************************************************/
+    class Screen : public streambuf {
+        // text of the frame being printed
+        string frame;
+
+        // lines of the page, of the frame shown below it, and on the terminal
+        vector<string> page, below, shown;
+
+        // has the terminal been cleared?
+        bool cleared;
+
+        // splits text into lines, with tabs expanded
+        static vector<string> lines(const string &text) {
+            vector<string> result(1);
+            for (string::const_iterator it = text.begin(); it != text.end(); ++it) {
+                if (*it == '\n') result.push_back("");
+                else if (*it == '\t') result.back().resize((result.back().size() / TAB_WIDTH + 1) * TAB_WIDTH, ' ');
+                else result.back() += *it;
+            } // for
+            // (text printed by the game ends with a newline)
+            if (result.back().empty()) result.pop_back();
+            return result;
+        } // lines()
+
+      protected:
+        int overflow(int ch) {
+            if (ch != EOF) frame += (char) ch;
+            return ch;
+        } // overflow()
+
+        streamsize xsputn(const char *s, streamsize n) {
+            frame.append(s, n);
+            return n;
+        } // xsputn()
+
+      public:
+        Screen() : cleared(false) {}
+
+        /*******************************************************************************
+         * present() draws the frame printed since the input was last read
+         * time: O(size of the screen)
+         * *****************************************************************************/
+        void present() {
+            if (frame.empty()) return;
+            vector<string> framed = lines(frame);
+            frame.clear();
+            if (framed.size() >= page.size()) {
+                page.swap(framed);
+                below.clear();
+            } else {
+                below.swap(framed);
+            } // else
+
+            // what the terminal should show (as much as fits)
+            struct winsize size;
+            const size_t rows = (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) 
+                                ? size.ws_row - 1 : DEFAULT_ROWS;
+            vector<string> visible(page);
+            visible.insert(visible.end(), below.begin(), below.end());
+            if (visible.size() > rows) visible.resize(rows);
+
+            // redraws every line from its first to its last changed character
+            string out;
+            if (!cleared) {
+                out += "\x1b[H\x1b[2J";
+                shown.clear();
+                cleared = true;
+            } // if
+            for (size_t row = 0; row < visible.size() || row < shown.size(); ++row) {
+                static const string NONE;
+                const string &line = row < visible.size() ? visible[row] : NONE;
+                const string &old = row < shown.size() ? shown[row] : NONE;
+                if (line == old) continue;
+                size_t first = 0;
+                while (first < line.size() && first < old.size() && line[first] == old[first]) ++first;
+                size_t last = line.size();
+                if (line.size() == old.size()) {
+                    while (last > first && line[last - 1] == old[last - 1]) --last;
+                } // if
+                moveTo(out, row, first);
+                out.append(line, first, last - first);
+                if (line.size() < old.size()) out += "\x1b[K";
+            } // for
+            moveTo(out, visible.size(), 0);
+            writeAll(out);
+            shown.swap(visible);
+        } // present()
+    };
+
+    /*******************************************************************************
+     * Writer hands what is printed to a thread of its own, which writes it to
+     * the standard output, in order: the text is appended to a chunk, and the
+     * chunks are passed through a ring of SLOTS of them (lock-free, as there is
+     * one producer and one consumer); a side only locks to sleep when the 
+     * writer has nothing to write, or the ring is full
+     * notes: chunks keep their storage once written, so that printing does not
+     *        allocate once the ring has warmed up
+     * *****************************************************************************/
+    class Writer : public streambuf {
+        // chunks in the ring (a power of 2), and size at which a chunk is 
+        // handed off without waiting for the input to be read
+        static const size_t SLOTS = 8;
+        static const size_t FULL_CHUNK = 1 << 14;
+
+        // the ring: the game appends to chunk head (modulo SLOTS), the writer
+        // writes chunks tail to head - 1
+        string chunks[SLOTS];
+        atomic<size_t> head, tail;
+
+        // where either side sleeps, and whether it does
+        mutex lock;
+        condition_variable changed;
+        atomic<bool> writerSleeping, gameWaiting;
+        bool stopping;
+
+        thread worker;
+
+        // wakes the other side up if it sleeps
+        void wake(const atomic<bool> &sleeping) {
+            if (!sleeping.load()) return;
+            lock_guard<mutex> guard(lock);
+            changed.notify_all();
+        } // wake()
+
+        // body of the writer: writes the chunks handed off until stopping
+        void work() {
+            while (true) {
+                const size_t next = tail.load(memory_order_relaxed);
+                if (next == head.load()) {
+                    unique_lock<mutex> guard(lock);
+                    writerSleeping = true;
+                    changed.wait(guard, [this, next]() { return next != head.load() || stopping; });
+                    writerSleeping = false;
+                    if (next == head.load()) return;
+                    continue;
+                } // if
+                string &chunk = chunks[next % SLOTS];
+                writeAll(chunk);
+                chunk.clear();
+                tail.store(next + 1);
+                wake(gameWaiting);
+            } // while
+        } // work()
+
+        // chunk being printed into
+        string& current() {
+            return chunks[head.load(memory_order_relaxed) % SLOTS];
+        } // current()
+
+      protected:
+        int overflow(int ch) {
+            if (ch == EOF) return ch;
+            current() += (char) ch;
+            if (current().size() >= FULL_CHUNK) handOff();
+            return ch;
+        } // overflow()
+
+        streamsize xsputn(const char *s, streamsize n) {
+            current().append(s, n);
+            if (current().size() >= FULL_CHUNK) handOff();
+            return n;
+        } // xsputn()
+
+      public:
+        Writer() : head(0), tail(0), writerSleeping(false), gameWaiting(false), stopping(false) {
+            worker = thread(&Writer::work, this);
+        } // Writer ctor
+
+        // writes what is pending, and stops the writer
+        ~Writer() {
+            handOff();
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            changed.notify_all();
+            worker.join();
+        } // ~Writer()
+
+        // hands the chunk being printed into to the writer
+        void handOff() {
+            if (current().empty()) return;
+            const size_t next = head.load(memory_order_relaxed) + 1;
+            if (next - tail.load() >= SLOTS) {
+                // waits for the writer to free the chunk after this one
+                unique_lock<mutex> guard(lock);
+                gameWaiting = true;
+                changed.wait(guard, [this, next]() { return next - tail.load() < SLOTS; });
+                gameWaiting = false;
+            } // if
+            head.store(next);
+            wake(writerSleeping);
+        } // handOff()
+    };
+
+    // writer of the standard output (NULL if none), and the stream printing
+    // through it
+    Writer *writer = NULL;
+    ostream *writerStream = NULL;
+
+    // terminal settings before raw mode, and the screen printing to the 
+    // terminal in raw mode (NULL in cooked mode)
+    struct termios cookedSettings;
+    volatile sig_atomic_t raw = 0;
+    Screen *screen = NULL;
+    ostream *screenStream = NULL;
+
+    // restores the terminal, when the game is interrupted or killed
+    void onSignal(const int sig) {
+        if (raw) tcsetattr(STDIN_FILENO, TCSAFLUSH, &cookedSettings);
+        signal(sig, SIG_DFL);
+        raise(sig);
+    } // onSignal()
+
+    // restores the terminal at exit
+    void atExit() {
+        Console::restoreTerminal();
+    } // atExit()
+
+    // input of a thread, read in bulk
+    class InputBuffer {
+        // stream read from (NULL for the standard input)
+        istream *source;
+
+        // characters read and not used yet, from next to end (in the buffer,
+        // or in the mapping of the standard input)
+        vector<char> buffer;
+        const char *next, *end;
+
+        // standard input mapped into memory (NULL if none), and its size; it
+        // is only mapped on the first read
+        void *mapping;
+        size_t mappingSize;
+        bool firstRead;
+
+        // has the end of the input been reached?
+        bool exhausted;
+
+        // maps the standard input into memory from its current position, if
+        // it is a file (false otherwise)
+        bool mapStandardInput() {
+            struct stat info;
+            if (fstat(STDIN_FILENO, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) return false;
+            const off_t position = lseek(STDIN_FILENO, 0, SEEK_CUR);
+            if (position < 0 || position >= info.st_size) return false;
+            void *m = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+            if (m == MAP_FAILED) return false;
+            mapping = m;
+            mappingSize = info.st_size;
+            next = (const char *) mapping + position;
+            end = (const char *) mapping + mappingSize;
+            // (the file is used as it is now; whatever is appended later is not)
+            exhausted = true;
+            return true;
+        } // mapStandardInput()
+
+        // reads the next chunk of the input (false at the end of the input)
+        bool refill() {
+            if (exhausted) return false;
+            if (!source && firstRead) {
+                firstRead = false;
+                if (mapStandardInput()) return true;
+            } // if
+
+            buffer.resize(CHUNK);
+            size_t count = 0;
+            if (source) {
+                source->read(&buffer[0], CHUNK);
+                count = source->gcount();
+            } else {
+                // (whoever is waiting for the input must see what it answers)
+                if (screen) screen->present();
+                else if (writer) writer->handOff();
+                else Console::out().flush();
+                ssize_t n;
+                do {
+                    n = ::read(STDIN_FILENO, &buffer[0], CHUNK);
+                } while (n == -1 && errno == EINTR);
+                count = n > 0 ? n : 0;
+            } // else
+            if (count == 0) {
+                exhausted = true;
+                return false;
+            } // if
+            next = &buffer[0];
+            end = next + count;
+            return true;
+        } // refill()
+
+      public:
+        InputBuffer() : source(NULL), next(NULL), end(NULL), mapping(NULL), mappingSize(0), 
+                        firstRead(true), exhausted(false) {}
+
+        ~InputBuffer() {
+            if (mapping) munmap(mapping, mappingSize);
+        } // ~InputBuffer()
+
+        // reads from in (the standard input if NULL) from now on
+        void reset(istream *in) {
+            if (mapping) munmap(mapping, mappingSize);
+            mapping = NULL;
+            mappingSize = 0;
+            firstRead = true;
+            source = in;
+            next = end = NULL;
+            exhausted = false;
+        } // reset()
+
+        // see Console::read()
+        bool read(char &ch) {
+            while (true) {
+                while (next != end) {
+                    const char c = *next++;
+                    if (!isSpace(c)) {
+                        ch = c;
+                        return true;
+                    } // if
+                } // while
+                if (!refill()) return false;
+            } // while
+        } // read()
+
+        // see Console::get()
+        int get() {
+            if (next == end && !refill()) return EOF;
+            return (unsigned char) *next++;
+        } // get()
+    };
+
+    // input the calling thread reads, and the stream it prints to (NULL for
+    // the standard one)
+    thread_local InputBuffer currentIn;
+    thread_local ostream *currentOut = 0;
+} // namespace
+
+// see console.h for details
+bool Console::read(char &ch) {
+    return currentIn.read(ch);
+} // read()
+
+// see console.h for details
+int Console::get() {
+    return currentIn.get();
+} // get()
+
+// see console.h for details
+ostream& Console::out() {
+    return currentOut ? *currentOut : cout;
+} // out()
+
+// see console.h for details
+void Console::use(istream *in, ostream *out) {
+    currentIn.reset(in);
+    currentOut = out;
+} // use()
+
+// see console.h for details
+bool Console::useRawTerminal() {
+    if (raw) return true;
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) return false;
+    if (tcgetattr(STDIN_FILENO, &cookedSettings) != 0) return false;
+    struct termios settings = cookedSettings;
+    settings.c_lflag &= ~(ICANON | ECHO);
+    settings.c_cc[VMIN] = 1;
+    settings.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &settings) != 0) return false;
+    raw = 1;
+
+    static bool registered = false;
+    if (!registered) {
+        atexit(atExit);
+        signal(SIGINT, onSignal);
+        signal(SIGTERM, onSignal);
+        signal(SIGHUP, onSignal);
+        registered = true;
+    } // if
+
+    cout.flush();
+    screen = new Screen();
+    screenStream = new ostream(screen);
+    currentOut = screenStream;
+    return true;
+} // useRawTerminal()
+
+// see console.h for details
+void Console::restoreTerminal() {
+    if (!raw) return;
+    screen->present();
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &cookedSettings);
+    raw = 0;
+    if (currentOut == screenStream) currentOut = NULL;
+    delete screenStream;
+    delete screen;
+    screenStream = NULL;
+    screen = NULL;
+} // restoreTerminal()
+
+// see console.h for details
+void Console::useWriterThread() {
+    if (writer) return;
+    cout.flush();
+    writer = new Writer();
+    writerStream = new ostream(writer);
+    currentOut = writerStream;
+} // useWriterThread()
+
+// see console.h for details
+void Console::stopWriterThread() {
+    if (!writer) return;
+    if (currentOut == writerStream) currentOut = NULL;
+    delete writerStream;
+    delete writer;
+    writerStream = NULL;
+    writer = NULL;
+} // stopWriterThread()
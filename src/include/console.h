@@ -0,0 +1,96 @@
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+#include <iostream>
+
+/*******************************************************************************
+ * Console gives the streams the game reads commands from and prints to, so
+ * that several games can be played at once (e.g. by the tests), each on its
+ * own thread with its own streams
+ * notes: commands are read in bulk, a buffer at a time (and standard input is
+ *        mapped into memory whole if it is a file), then scanned character by
+ *        character without going through the stream; commands are short and
+ *        context-dependent (the same letter is a move, a help option, a race
+ *        or a merchant's item), so they are split as they are read
+ * *****************************************************************************/
+class Console {
+  public:
+    /*******************************************************************************
+     * read(ch) reads the next character of the input that is not whitespace
+     *  into ch, as in >> ch does
+     * notes: returns false at the end of the input
+     *        reads from std::cin unless another stream is used (see use());
+     *        waiting for more input flushes out() first, as std::cin does
+     * time: O(#whitespace characters skipped) amortized
+     * *****************************************************************************/
+    static bool read(char &ch);
+
+    /*******************************************************************************
+     * get() reads the next character of the input, whitespace included, as
+     *  in.get() does
+     * notes: returns EOF at the end of the input
+     * time: O(1) amortized
+     * *****************************************************************************/
+    static int get();
+
+    /*******************************************************************************
+     * out() gets the stream the calling thread prints to
+     * notes: std::cout unless another stream is used (see use())
+     * time: O(1)
+     * *****************************************************************************/
+    static std::ostream& out();
+
+    /*******************************************************************************
+     * use(in, out) makes the calling thread read from in and print to out (or
+     *  from std::cin and to std::cout if they are NULL)
+     * notes: drops whatever was read in bulk from the previous input and not
+     *        used yet
+     * required: in and out outlive their use
+     *           nothing else reads from in while it is used
+     * time: O(1)
+     * *****************************************************************************/
+    static void use(std::istream *in, std::ostream *out);
+
+    /*******************************************************************************
+     * useRawTerminal() puts the terminal in raw mode, so that every key is read
+     *  as soon as it is pressed (without echo, nor waiting for Enter), and makes
+     *  the calling thread print to the terminal by redrawing only the 
+     *  characters that changed since the input was last read
+     * notes: returns false, changing nothing, if the standard input or output
+     *        is not a terminal (e.g. when the commands come from a file)
+     *        the screen shows a page, followed by the last frame (the text 
+     *        printed between two reads of the input); a frame at least as tall
+     *        as the page (e.g. one showing the floor) becomes the page
+     *        the terminal is restored by restoreTerminal(), at exit, and when
+     *        the game is interrupted or killed
+     * required: the calling thread reads from and prints to the standard 
+     *           streams
+     * time: O(1)
+     * *****************************************************************************/
+    static bool useRawTerminal();
+
+    /*******************************************************************************
+     * restoreTerminal() shows what was printed last, and restores the terminal
+     *  (if useRawTerminal() put it in raw mode)
+     * time: O(size of the screen)
+     * *****************************************************************************/
+    static void restoreTerminal();
+
+    /*******************************************************************************
+     * useWriterThread() makes the calling thread print to the standard output
+     *  through a writer thread, so that the game goes on with the next command
+     *  while the text of a turn is written: what is printed is handed to the 
+     *  writer in chunks, through a lock-free queue, whenever the input is about
+     *  to be read or a chunk is full
+     * notes: the text is written in the order it was printed, exactly as it 
+     *        would have been without the writer
+     *        stopWriterThread() writes what is pending and stops the writer
+     * required: the calling thread prints to the standard output, and nothing
+     *           else does while the writer is used
+     * time: O(1)
+     * *****************************************************************************/
+    static void useWriterThread();
+    static void stopWriterThread();
+};
+
+#endif
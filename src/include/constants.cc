@@ -11,6 +11,34 @@
 using namespace std;
 using namespace constants;
 
+// see constants.h for details
+const RaceInfo constants::RACES[NUM_RACES] = {
+    {"Human", "drops " + to_string(HUMAN_GOLD_PILES) + " normal piles of gold"},
+    {"Dwarf", "Vampires are allergic to dwarves and lose" + to_string(-DWARF_VAMPIRE_HP_LOSS) 
+              + " HP rather than gain"},
+    {"Elf", "gets " + to_string(ELF_NUM_ATTACKS) + " attacks against every race except Drow"},
+    {"Orc", "does 50% more damage to goblins"},
+    {"Merchant", "trades potions"},
+    {"Dragon", "always guards a treasure hoard"},
+    {"Halfling", "has a 50% to beguile the player character and cause them to miss"},
+    {"Shade", "final score magnified by 1.5"},
+    {"Drow", "all potions have their effect magnified by 1.5"},
+    {"Vampire", "gains " + to_string(VAMP_HP_GAIN) + " HP every successful attack and has no maximum HP"},
+    {"Troll", "regains " + to_string(TROLL_HP_REJUVENATION) + " HP every turn (HP capped at " 
+              + to_string(TROLL_HP) + ")"},
+    {"Goblin", "steals " + to_string(GOBLIN_GOLD_STEAL) + " gold from every slain enemy"}
+};
+
+// see constants.h for details
+const string constants::POTION_EFFECTS[NUM_POTION_TYPES] = {
+    "restore up to " + to_string(RH_HP_VALUE) + " HP",
+    "increase ATK by " + to_string(BA_ATK_VALUE),
+    "increase Def by " + to_string(BD_DEF_VALUE),
+    "lose up to " + to_string(-PH_HP_VALUE) + " HP",
+    "decrease Atk by " + to_string(-WA_ATK_VALUE),
+    "decrease Def by " + to_string(-WD_DEF_VALUE)
+};
+
 // see constants.h for details
 int constants::findChamberNum(const int row, const int col){
     if (col >= lCol0 && col <= rCol0 && row >= lRow0 && row <= rRow0) return 0;
@@ -25,6 +53,14 @@ int constants::findChamberNum(const int row, const int col){
     return -1;
 } // findChamberNum()
 
+// see constants.h for details
+int constants::getDirectionIndex (const string dir) {
+    for (int i = 0; i < NUM_DIRECTIONS; ++i) {
+        if (DIRECTIONS[i] == dir) return i;
+    } // for
+    return -1;
+} // getDirectionIndex()
+
 // see constants.h for details
 string constants::getFullDirection (const string dir) {
     if (dir == "no") return "north";
@@ -8,14 +8,27 @@
 
 namespace constants {
     // default configuration file
-    const std::string EMPTY_CONFIG = ".\\src\\include\\emptyconfig.txt";
+    const std::string EMPTY_CONFIG = "src/include/emptyconfig.txt";
 
     /************************ CONFIGURATION CONSTANTS *******************************/
 
+    // dimensions and number of chambers of the original board
     const int NUM_ROWS = 25, NUM_COLS = 79;
     const int NUM_CHAMBERS = 5;
     const int NUM_FLOORS = 5;
 
+    // part of the board printed around the PC on boards larger than this
+    const int VIEWPORT_ROWS = NUM_ROWS, VIEWPORT_COLS = NUM_COLS;
+
+    // cells are stored in square chunks of this side;
+    // chunks containing only empty space are not stored
+    const int CHUNK_SIZE = 64;
+
+    // largest number of walkable tiles for which all distances are precomputed
+    const int MAX_DISTANCE_TABLE_TILES = 4096;
+
+    // chamber rectangles of the original board; chambers of other boards 
+    // are found from the configuration itself
     // chamber 0
     const int lRow0 = 3, rRow0 = 6, lCol0 = 3, rCol0 = 28;
     // chamber 1
@@ -35,7 +48,8 @@ namespace constants {
     const int MAX_CHAMBER_LOAD = 30;
 
     /*******************************************************************************
-     * findChamberNum(row, col) determines what chamber Cell (row, col) is in
+     * findChamberNum(row, col) determines what chamber Cell (row, col) of the
+     *  original board is in
      * notes: if not a floor tile, returns -1
      * time: O(1)
      * *****************************************************************************/
@@ -62,6 +76,17 @@ namespace constants {
         {"we", std::make_pair(0,-1)}
     };
 
+    // (vShift, hShift) of every direction, in the order of DIRECTIONS
+    const int ROW_OFFSETS[NUM_DIRECTIONS] = {-1, -1, -1, 1, 1, 1, 0, 0};
+    const int COL_OFFSETS[NUM_DIRECTIONS] = {0, -1, 1, 0, -1, 1, 1, -1};
+
+    /*******************************************************************************
+     * getDirectionIndex(dir) gets the position of dir in DIRECTIONS
+     * notes: returns -1 if dir is not one of no, so, sw, se, nw, ne, ea, we
+     * time: O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    int getDirectionIndex (const std::string dir);
+
     /*******************************************************************************
      * getFullDirection(dir) translates short-hand directions to their full name
      * required: dir is one of no, so, sw, se, nw, ne, ea, we
@@ -77,6 +102,28 @@ namespace constants {
     /*************************** ENEMY CONSTANTS *******************************/
 
     const int NUM_ENEMIES_PER_FLOOR = 20;
+
+    // the PC acts once every TICKS_PER_TURN ticks; an enemy of speed s acts
+    // every TICKS_PER_TURN * NORMAL_SPEED / s ticks (1 <= s <= MAX_SPEED)
+    const int TICKS_PER_TURN = 12;
+    const int NORMAL_SPEED = 12;
+    const int MAX_SPEED = TICKS_PER_TURN * NORMAL_SPEED;
+
+    // except in exact mode, enemies outside the PC's chamber and more than 
+    // this many tiles away from the PC sleep (see --radius)
+    const int DEFAULT_WAKE_RADIUS = 8;
+
+    // floors with fewer enemies than this keep them all awake, as in exact 
+    // mode (waking them near the PC costs more than their sleep saves)
+    const int MIN_SLEEPING_ENEMIES = 8;
+
+    // a sleeping enemy that missed at least this many moves wakes up anywhere
+    // in its chamber; otherwise it makes the moves it missed
+    const int CATCH_UP_MIXING_MOVES = 32;
+
+    // fewer enemies acting in a turn than this are not worth handing to other 
+    // threads (see --threads)
+    const int MIN_PARALLEL_ENEMIES = 64;
     
     // spawn probabilities
     const int ENEMY_DENOMINATOR = 18;
@@ -87,39 +134,45 @@ namespace constants {
     const int PROB_ORC = 2;
     const int PROB_MERCHANT = 2;
 
+    /*******************************************************************************
+     * RaceInfo describes a race as it is printed: its name and its ability
+     * notes: the descriptions are built once (in constants.cc) and shared by
+     *        every character, which only holds the index of its race in RACES
+     * *****************************************************************************/
+    struct RaceInfo {
+        std::string name;
+        std::string ability;
+    };
+
+    // races of the characters, in the order of RACES
+    enum Race : unsigned char {HUMAN, DWARF, ELF, ORC, MERCHANT, DRAGON, HALFLING, 
+                               SHADE, DROW, VAMPIRE, TROLL, GOBLIN, NUM_RACES};
+    extern const RaceInfo RACES[NUM_RACES];
+
     // race-specific attributes
     const int HUMAN_HP = 140;
     const int HUMAN_ATK = 20;
     const int HUMAN_DEF = 20;
     const int HUMAN_GOLD_PILES = 2;
-    const std::string HUMAN_ABILITY = "drops " + std::to_string(HUMAN_GOLD_PILES) 
-                                      + " normal piles of gold";
 
     const int DWARF_HP = 100;
     const int DWARF_ATK = 20;
     const int DWARF_DEF = 30;
     const int DWARF_VAMPIRE_HP_LOSS = -5;
-    const std::string DWARF_ABILITY = "Vampires are allergic to dwarves and lose" 
-                                      + std::to_string(-DWARF_VAMPIRE_HP_LOSS) 
-                                      + " HP rather than gain";
 
     const int ELF_HP = 140;
     const int ELF_ATK = 30;
     const int ELF_DEF = 10;
     const int ELF_NUM_ATTACKS = 2;
-    const std::string ELF_ABILITY = "gets " + std::to_string(ELF_NUM_ATTACKS)  
-                                    + " attacks against every race except Drow";
 
     const int ORC_HP = 180;
     const int ORC_ATK = 30;
     const int ORC_DEF = 25;
     const float ORC_ON_GOBLIN_DAMAGE_MULTIPLIER = 1.5;
-    const std::string ORC_ABILITY = "does 50% more damage to goblins";
 
     const int MERCH_HP = 30;
     const int MERCH_ATK = 70;
     const int MERCH_DEF = 5;
-    const std::string MERCH_ABILITY = "trades potions";
     const int MERCH_MAX_NUM_POTIONS = 6;
     const int MERCH_MAX_FEE = 3;
     const int MERCH_MAX_STEAL = 2;
@@ -129,13 +182,11 @@ namespace constants {
     const int DRAGON_HP = 150;
     const int DRAGON_ATK = 20;
     const int DRAGON_DEF = 20;
-    const std::string DRAGON_ABILITY = "always guards a treasure hoard";
 
     const int HALFLING_HP = 100;
     const int HALFLING_ATK = 15;
     const int HALFLING_DEF = 20;
     const int HALFLING_MISS_DENOM = 2;
-    const std::string HALFLING_ABILITY = "has a 50% to beguile the player character and cause them to miss";
 
     /***************************** PC CONSTANTS ***********************************/
 
@@ -144,34 +195,25 @@ namespace constants {
     const int SHADE_ATK = 25;
     const int SHADE_DEF = 25;
     const float SHADE_SCORE_MULTIPLIER = 1.5;
-    const std::string SHADE_ABILITY = "final score magnified by 1.5";
 
     const int DROW_HP = 150;
     const int DROW_ATK = 25;
     const int DROW_DEF = 15;
     const float DROW_POTION_MULTIPLIER = 1.5;
-    const std::string DROW_ABILITY = "all potions have their effect magnified by 1.5";
 
     const int VAMP_HP = 50;
     const int VAMP_ATK = 25;
     const int VAMP_DEF = 25;
     const int VAMP_HP_GAIN = 5;
     const int VAMP_HP_LOSS_DWARF = -5;
-    const std::string VAMP_ABILITY = "gains " + std::to_string(VAMP_HP_GAIN) 
-                                     + " HP every successful attack and has no maximum HP";
     const int TROLL_HP = 120;
     const int TROLL_ATK = 25;
     const int TROLL_DEF = 15;
     const int TROLL_HP_REJUVENATION = 5;
-    const std::string TROLL_ABILITY = "regains " + std::to_string(TROLL_HP_REJUVENATION) 
-                                      + " HP every turn (HP capped at " 
-                                      + std::to_string(TROLL_HP) + ")";
     const int GOBLIN_HP = 110;
     const int GOBLIN_ATK = 15;
     const int GOBLIN_DEF = 20; 
     const int GOBLIN_GOLD_STEAL = 5; 
-    const std::string GOBLIN_ABILITY = "steals " + std::to_string(GOBLIN_GOLD_STEAL) 
-                                       + " gold from every slain enemy";
 
     // dodge probability denominator for enemy attacks
     const int PC_DODGE_DENOM = 2;
@@ -201,6 +243,12 @@ namespace constants {
     const int WA_ATK_VALUE = -5;
     const int WD_DEF_VALUE = -5;
 
+    // types of potions, and the description of the effect of every type (built
+    // once, as the races' are)
+    enum PotionType : unsigned char {RH_POTION, BA_POTION, BD_POTION, PH_POTION, WA_POTION, WD_POTION, 
+                                     NUM_POTION_TYPES};
+    extern const std::string POTION_EFFECTS[NUM_POTION_TYPES];
+
 } // namespace constants
 
 #endif
\ No newline at end of file
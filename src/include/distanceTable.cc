@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * distanceTable.cc
+ * 
+ * Module implementing the table of distances between tiles of a layout.
+ * ****************************************************************************/
+
+#include "distanceTable.h"
+#include "layout.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+const unsigned short DistanceTable::UNREACHABLE;
+
+// see distanceTable.h for details
+DistanceTable::DistanceTable(const Layout &layout) : 
+        numCols(layout.getNumCols()), numWalkable(0), 
+        ids(layout.getNumRows() * layout.getNumCols(), -1) {
+    // numbers the walkable tiles
+    for (int row = 0; row < layout.getNumRows(); ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            if (layout.isWalkable(row, col)) ids[row * numCols + col] = numWalkable++;
+        } // for
+    } // for
+
+    // stores the walkable neighbors of every walkable tile contiguously
+    firstNeighbor.assign(numWalkable + 1, 0);
+    for (int row = 0; row < layout.getNumRows(); ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            const int id = ids[row * numCols + col];
+            if (id == -1) continue;
+            for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+                if (layout.isWalkable(row + ROW_OFFSETS[dir], col + COL_OFFSETS[dir])) {
+                    neighbors.push_back(ids[(row + ROW_OFFSETS[dir]) * numCols + col + COL_OFFSETS[dir]]);
+                } // if
+            } // for
+            firstNeighbor[id + 1] = neighbors.size();
+        } // for
+    } // for
+
+    // breadth-first search from every walkable tile
+    if (numWalkable > MAX_DISTANCE_TABLE_TILES) return;
+    table.resize(numWalkable * numWalkable);
+    for (int source = 0; source < numWalkable; ++source) {
+        search(source, &table[source * numWalkable]);
+    } // for
+} // DistanceTable ctor
+
+// see distanceTable.h for details
+void DistanceTable::search(const int source, unsigned short *dist) const {
+    for (int i = 0; i < numWalkable; ++i) dist[i] = UNREACHABLE;
+    vector<int> queue(numWalkable);
+    int tail = 0;
+    dist[source] = 0;
+    queue[tail++] = source;
+    for (int head = 0; head < tail; ++head) {
+        const int v = queue[head];
+        for (int i = firstNeighbor[v]; i < firstNeighbor[v + 1]; ++i) {
+            const int w = neighbors[i];
+            if (dist[w] != UNREACHABLE) continue;
+            dist[w] = dist[v] + 1;
+            queue[tail++] = w;
+        } // for
+    } // for
+} // search()
+
+// see distanceTable.h for details
+unsigned short DistanceTable::distance(const int fromRow, const int fromCol, 
+                                       const int toRow, const int toCol, Row &row) const {
+    const int from = ids[fromRow * numCols + fromCol];
+    const int to = ids[toRow * numCols + toCol];
+    if (from == -1 || to == -1) return UNREACHABLE;
+    if (!table.empty()) return table[from * numWalkable + to];
+
+    // layout is too large for a table
+    if (from != row.source) {
+        row.distances.resize(numWalkable);
+        search(from, &row.distances[0]);
+        row.source = from;
+    } // if
+    return row.distances[to];
+} // distance()
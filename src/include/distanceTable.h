@@ -0,0 +1,74 @@
+#ifndef __DISTANCE_TABLE_H__
+#define __DISTANCE_TABLE_H__
+
+#include <vector>
+
+class Layout;
+
+class DistanceTable {
+    // number of columns of the layout
+    const int numCols;
+
+    // number of walkable tiles
+    int numWalkable;
+
+    // index of every tile among the walkable tiles (-1 if not walkable)
+    std::vector<int> ids;
+
+    // walkable neighbors of walkable tile i are 
+    // neighbors[firstNeighbor[i]], ..., neighbors[firstNeighbor[i + 1] - 1]
+    std::vector<int> firstNeighbor;
+    std::vector<int> neighbors;
+
+    // distance between walkable tiles i and j is stored at i * numWalkable + j
+    // (empty if there are more than MAX_DISTANCE_TABLE_TILES walkable tiles)
+    std::vector<unsigned short> table;
+
+    /*******************************************************************************
+     * search(source, dist) stores in dist[i] the distance from walkable tile
+     *  source to walkable tile i
+     * required: dist has room for numWalkable distances
+     * time: O(#walkable tiles)
+     * *****************************************************************************/
+    void search(const int source, unsigned short *dist) const;
+
+  public:
+    // distance between tiles that are not connected
+    static const unsigned short UNREACHABLE = 0xFFFF;
+
+    /*******************************************************************************
+     * Row holds the distances from the last tile a caller asked about, on 
+     *  layouts too large for a table (see distance())
+     * notes: tables are shared by threads, so every caller keeps its own row
+     * *****************************************************************************/
+    struct Row {
+        int source;
+        std::vector<unsigned short> distances;
+        Row() : source(-1) {}
+    };
+
+    /*******************************************************************************
+     * DistanceTable constructor computes the length of the shortest walk between
+     *  every pair of walkable tiles of layout
+     * notes: moves are in any of the 8 directions, between walkable tiles
+     *        layouts with more than MAX_DISTANCE_TABLE_TILES walkable tiles are
+     *        too large for a table; their distances are computed when asked for
+     * time: O(#walkable tiles^2), O(#walkable tiles) for large layouts
+     * *****************************************************************************/
+    explicit DistanceTable(const Layout &layout);
+
+    /*******************************************************************************
+     * distance(fromRow, fromCol, toRow, toCol, row) gets the number of moves 
+     *  needed to walk from (fromRow, fromCol) to (toRow, toCol)
+     * notes: returns UNREACHABLE if either tile is not walkable or they are
+     *        not connected
+     *        on large layouts, computes the distances from (fromRow, fromCol)
+     *        into row, unless row already holds them
+     * time: O(1); for large layouts, O(#walkable tiles) unless the previous
+     *       call with row was from the same tile
+     * *****************************************************************************/
+    unsigned short distance(const int fromRow, const int fromCol, 
+                            const int toRow, const int toCol, Row &row) const;
+};
+
+#endif
@@ -5,44 +5,78 @@
  * ****************************************************************************/
 
 #include <sstream>
+#include <vector>
 #include <ctime>
 #include "game.h"
 #include "pc.h"
 #include "constants.h"
+#include "rng.h"
+#include "trace.h"
+#include "console.h"
 
 using namespace std;
 
+namespace {
+    // writes what is pending, restores the terminal and finishes the trace
+    // when destroyed, however the game ends
+    struct Cleanup {
+        ~Cleanup() {
+            Console::stopWriterThread();
+            Console::restoreTerminal();
+            Trace::stop();
+        } // ~Cleanup()
+    };
+} // namespace
+
 int main(int argc, char *argv[]) {
+    // separates switches (e.g. --compat) from positional arguments
+    GameOptions options;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) args.push_back(arg);
+        else if (!parseOption(arg, options)) {
+            cerr << "Invalid option: " << arg << endl;
+            return 1;
+        } // else if
+    } // for
+
     int seed = time(NULL);
     // gets seed for testing, if any
-    if (argc == 3) {
-        istringstream is (argv[2]);
+    if (args.size() >= 2) {
+        istringstream is (args[1]);
         is >> seed;
         cerr << seed << endl;
     } // if
-    srand(seed);
+    Rng::current().seed(seed);
 
     // gets filename for floor configurations (if any)
     string filename = constants::EMPTY_CONFIG;
-    if (argc >= 2) {
-        istringstream is (argv[1]);
+    if (args.size() >= 1) {
+        istringstream is (args[0]);
         is >> filename;
     } // if
 
+    // records a trace if asked to
+    if (!options.traceFile.empty() && !Trace::start(options.traceFile)) {
+        cerr << "Cannot write trace file: " << options.traceFile << endl;
+        return 1;
+    } // if
+
+    // reads keys as they are pressed if asked to (and playing on a terminal);
+    // otherwise, prints through a writer thread
+    if (!options.raw || !Console::useRawTerminal()) Console::useWriterThread();
+
     // plays game until player wins, loses, or quits
-    try {  
-        while(1) {
-            try {
-                playGame(filename);
-            } catch (PCRestart &e) {
-                cout << "The game restarts." << endl;
-            } // catch
-        } // while
-    } catch (PCSlain &e) {
-        cout << "Game over." << endl;
-    } catch (PCQuit &e) {
-        cout << "You quit." << endl;
-    } catch (PCWon &e) {
-        cout << "Congratulations! You WIN!!!!" << endl;        
+    try {
+        const Cleanup cleanup;
+        playGames(filename, options);
+    } catch (GameError &e) {
+        // (the error has been reported)
+        return 1;
+    } catch (...) {
+        // (catching the error unwinds the cleanup, which an uncaught error 
+        // might not)
+        throw;
     } // catch
 } // main()
\ No newline at end of file
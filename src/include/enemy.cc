@@ -5,20 +5,25 @@
  * ****************************************************************************/
 
 #include <cassert>
+#include <algorithm>
 #include <iostream>
 #include "constants.h"
+#include "rng.h"
+#include "arena.h"
 #include "enemy.h"
 #include "item.h"
 #include "pc.h"
 #include "cell.h"
+#include "console.h"
 
 using namespace std;
 using namespace constants;
 
 // constructor
-Enemy::Enemy(const std::string race, const int hp, const int atk, 
-            const int def, const char token, const std::string ability)
-                : Player(race,hp,hp,atk,def, token, ability) {}
+Enemy::Enemy(const Race race, const int hp, const int atk, 
+            const int def, const char token)
+                : Player(race,hp,hp,atk,def, token), actTime(0), actOrder(0), 
+                  parked(false) {}
 
 // see enemy.h for details
 void Enemy::modifyHP(const int amount) {
@@ -32,7 +37,7 @@ void Enemy::modifyHP(const int amount) {
 void Enemy::dodgesAttack(Player &attacker) {}
 
 // see enemy.h for details
-void Enemy::initiateTalks() const {throw NotInterested();}
+void Enemy::initiateTalks(const PC &pc) const {throw NotInterested();}
 
 // see enemy.h for details
 void Enemy::makeMove(const string dir) {
@@ -42,10 +47,23 @@ void Enemy::makeMove(const string dir) {
     if (!target.isFloorTile()) throw UnwalkableCell();
     if (target.containsItem()) throw CellContainsItem();
 
-    // performs the move
+    moveTo(target);
+} // Enemy::makeMove()
+
+// see enemy.h for details
+bool Enemy::canMove() const {return true;}
+
+// see enemy.h for details
+int Enemy::getSpeed() const {return NORMAL_SPEED;}
+
+// see enemy.h for details
+bool Enemy::isHostileToPC(const PC &pc) const {return true;}
+
+// see enemy.h for details
+void Enemy::moveTo(Cell &target) {
     getLocation()->enemyMovesOut();
     target.characterMovesIn(*this);
-} // Enemy::makeMove()
+} // Enemy::moveTo()
 
 // see enemy.h for details
 PC& Enemy::enemyAttackPrep(const std::string dir){
@@ -69,7 +87,7 @@ void Enemy::attackInDirection(const string dir) {
 
 // see enemy.h for details
 void Enemy::dropGold(PC& pc) const{
-    const int i = rand() % DROP_GOLD_PROB_DENOM;
+    const int i = Rng::current().next() % DROP_GOLD_PROB_DENOM;
     if (i == 0) (new SmallHoard())->pickUp(pc);
     else (new NormalHoard())->pickUp(pc);
 } // Enemy::dropGold(PC&)
@@ -111,7 +129,7 @@ void Merchant::struckBy(Vampire& pc) {
 /****************************** Enemy Factory Method *********************************/
 // see enemy.h for details
 Enemy * createEnemy() {
-    int random = rand() % ENEMY_DENOMINATOR;
+    int random = Rng::current().next() % ENEMY_DENOMINATOR;
     if (random < PROB_HUMAN) return new Human();
     random -= PROB_HUMAN;
     if (random < PROB_DWARF) return new Dwarf();
@@ -125,34 +143,28 @@ Enemy * createEnemy() {
 } // createEnemy()
 
 /****************************** Enemy Race Constructors **********************************/
-Human::Human(): Enemy("Human", HUMAN_HP, HUMAN_ATK, HUMAN_DEF, 'H', HUMAN_ABILITY) {}
+Human::Human(): Enemy(HUMAN, HUMAN_HP, HUMAN_ATK, HUMAN_DEF, 'H') {}
 
-Dwarf::Dwarf(): Enemy("Dwarf", DWARF_HP, DWARF_ATK, DWARF_DEF, 'W', DWARF_ABILITY) {}
+Dwarf::Dwarf(): Enemy(DWARF, DWARF_HP, DWARF_ATK, DWARF_DEF, 'W') {}
 
-Elf::Elf(): Enemy("Elf", ELF_HP, ELF_ATK, ELF_DEF, 'E', ELF_ABILITY) {}
+Elf::Elf(): Enemy(ELF, ELF_HP, ELF_ATK, ELF_DEF, 'E') {}
 
-Orc::Orc(): Enemy("Orc", ORC_HP, ORC_ATK, ORC_DEF, 'O', ORC_ABILITY) {}
+Orc::Orc(): Enemy(ORC, ORC_HP, ORC_ATK, ORC_DEF, 'O') {}
 
-Merchant::Merchant(): Enemy("Merchant", MERCH_HP, MERCH_ATK, MERCH_DEF,'M'), 
-                      fee(1 + rand() % (MERCH_MAX_FEE-1)) {
+Merchant::Merchant(): Enemy(MERCHANT, MERCH_HP, MERCH_ATK, MERCH_DEF,'M'), 
+                      fee(1 + Rng::current().next() % (MERCH_MAX_FEE-1)), 
+                      inventory(NULL), numPotions(0) {
     generatePotions();
 }
 
-Dragon::Dragon(): Enemy("Dragon", DRAGON_HP, DRAGON_ATK, DRAGON_DEF, 'D', DRAGON_ABILITY) {}
-
-Halfling::Halfling(): Enemy("Halfling", HALFLING_HP, HALFLING_ATK, HALFLING_DEF, 'L', HALFLING_ABILITY) {}
+Dragon::Dragon(): Enemy(DRAGON, DRAGON_HP, DRAGON_ATK, DRAGON_DEF, 'D'), dh(NULL) {}
 
-// Merchant destructor
-Merchant::~Merchant(){
-    // deletes potions
-    for (vector<Potion *>::iterator it = inventory.begin(); it != inventory.end(); ++it) {
-        delete (*it);
-    } // for
-} // ~Merchant()
+Halfling::Halfling(): Enemy(HALFLING, HALFLING_HP, HALFLING_ATK, HALFLING_DEF, 'L') {}
 
 // Dragon destructor
 Dragon::~Dragon(){
-    dh->detachDragon();
+    // (a floor that fails to be built may free its dragons before linking them)
+    if (dh) dh->detachDragon();
 } // ~Dragon()
 
 /************************** Race-Specific Overloaded Methods ********************************/
@@ -176,60 +188,53 @@ void Orc::attackInDirection(const string dir) {
     enemyAttackPrep(dir).struckBy(*this);
 } // Orc::attackInDirection()
 
-// merchants are not hostile initially
-bool Merchant::isHostile = false;
-
 // see enemy.h for details
 void Merchant::generatePotions(){
-    assert(inventory.empty());
-    const int numPotions = rand() % MERCH_MAX_NUM_POTIONS;
-    for (int j = 0; j < numPotions; ++j) {
-        inventory.push_back((Potion *) createItem('P'));
+    assert(numPotions == 0);
+    const int num = Rng::current().next() % MERCH_MAX_NUM_POTIONS;
+    inventory = static_cast<Potion **>(Arena::current().allocate(num * sizeof(Potion *)));
+    for (; numPotions < num; ++numPotions) {
+        inventory[numPotions] = (Potion *) createItem('P');
     } // for
 } // Merchant::generatePotions()
 
 // see enemy.h for details
 void Merchant::makeHostile(PC &pc){
-    if (!isHostile) {
-        isHostile = true;
+    if (!pc.areMerchantsHostile()) {
+        pc.makeMerchantsHostile();
         pc.addAction("Merchants are now hostile to Player Character");
     } // if
 } // makeHostile()
 
 // see enemy.h for details
-void Merchant::resetHostile() {
-    isHostile = false;
-} // resetHostile()
+bool Merchant::isHostileToPC(const PC &pc) const {
+    return pc.areMerchantsHostile();
+} // Merchant::isHostileToPC()
 
 // see enemy.h for details
-bool Merchant::areMerchantsHostile() {
-    return isHostile;
-} // areMerchantsHostile()
-
-// see enemy.h for details
-void Merchant::initiateTalks() const {
-    if (areMerchantsHostile() || inventory.empty() || rand() % MERCH_PROB_REFUSE == 0) {
+void Merchant::initiateTalks(const PC &pc) const {
+    if (pc.areMerchantsHostile() || numPotions == 0 || Rng::current().next() % MERCH_PROB_REFUSE == 0) {
         throw NotInterested();
     } // if
 } // Merchant::initiateTalks()
 
 // see enemy.h for details
 void Merchant::printInventory() const {
-    cout << "Merchant's Inventory:" << endl;
-    for (vector<Potion *>::const_iterator it = inventory.begin(); it != inventory.end(); ++it) {
-        cout << '(' << (char) ('a' + it - inventory.begin()) << ") " << **it << endl;
+    Console::out() << "Merchant's Inventory:" << endl;
+    for (int i = 0; i < numPotions; ++i) {
+        Console::out() << '(' << (char) ('a' + i) << ") " << *inventory[i] << endl;
     } // for
-    cout << "Fee: " << fee << endl << endl;
+    Console::out() << "Fee: " << fee << endl << endl;
 } // printInventory()
 
 // see enemy.h for details
 void Merchant::performTransaction(Player &pc, const char choice, const string dir){
-    if('a' > choice || choice >= 'a' + inventory.size()) throw InvalidChoice();
+    if('a' > choice || choice >= 'a' + numPotions) throw InvalidChoice();
     const int index = choice - 'a';
 
     // checks that PC has enough money
     if (pc.getGold() < fee) {
-        cout << "Player Character has insufficient funds." << endl;
+        Console::out() << "Player Character has insufficient funds." << endl;
         throw NoDeal();
     } // if
 
@@ -242,9 +247,9 @@ void Merchant::performTransaction(Player &pc, const char choice, const string di
     pc.addAction("Player Character transfers " + to_string(fee) + " gold to M");
 
     // determines whether merchant will steal
-    if (rand() % MERCH_STEAL_PROB_DENOM) {
+    if (Rng::current().next() % MERCH_STEAL_PROB_DENOM) {
         // cannot steal more gold than PC has
-        const int steal = min ((rand() % MERCH_MAX_STEAL), pc.getGold());
+        const int steal = min ((Rng::current().next() % MERCH_MAX_STEAL), pc.getGold());
         if (steal > 0) {
             pc.modifyGold(-steal);
             pc.addAction("M steals an additional " + to_string(steal) + " gold from Player Character");
@@ -252,16 +257,19 @@ void Merchant::performTransaction(Player &pc, const char choice, const string di
     } // if
 
     // gives item to PC
-    inventory.at(index)->pickUp(pc);
+    inventory[index]->pickUp(pc);
 
-    // remove potion that was bought from merchant's inventory
-    delete inventory.at(index);
-    inventory.erase(inventory.begin() + index);
+    // remove potion that was bought from merchant's inventory (its storage
+    // goes with the floor's arena)
+    copy(inventory + index + 1, inventory + numPotions, inventory + index);
+    --numPotions;
 } // performTransaction()
 
 // see enemy.h for details
 void Merchant::attackInDirection(const string dir) {
-    if (!Merchant::isHostile) throw NotHostile();
+    // only attacks a PC the merchants are hostile to
+    const Cell &target = findTargetCellAttack(dir);
+    if (target.isOccupiedByPC() && !target.getPC()->areMerchantsHostile()) throw NotHostile();
     // attacks PC
     enemyAttackPrep(dir).struckBy(*this);
 } // Merchant::attackInDirection()
@@ -274,6 +282,9 @@ void Merchant::dropGold(PC& pc) const{
 // see enemy.h for details
 void Dragon::makeMove(const string dir) {}
 
+// see enemy.h for details
+bool Dragon::canMove() const {return false;}
+
 // see enemy.h for details
 void Dragon::attachDH(DragonHoard &hoard) {
     dh = &hoard;
@@ -284,7 +295,7 @@ void Dragon::dropGold(PC& pc) const{}
 
 // see enemy.h for details
 void Halfling::dodgesAttack(Player &attacker) {
-    if (rand() % HALFLING_MISS_DENOM) {
+    if (Rng::current().next() % HALFLING_MISS_DENOM) {
         attacker.addAction("L beguiles the Player Character and causes them to miss");
         throw AttackDodged();
     } // if
@@ -9,14 +9,24 @@
 class DragonHoard;
 
 class Enemy : public Player {
+    // when the enemy acts next, in ticks, and its place among the enemies
+    // acting at the same time (see Scheduler)
+    int actTime;
+    int actOrder;
+
+    // has the enemy been put to sleep by the scheduler?
+    bool parked;
+
+    friend class Scheduler;
+
   protected:
     /*******************************************************************************
      * Enemy constructor
      * notes: an Enemy cannot be constructed directly; must use factory method
      * time: O(1)
      * *****************************************************************************/
-    Enemy(const std::string race, const int hp, const int atk, 
-          const int def, const char token, const std::string ability = "");
+    Enemy(const constants::Race race, const int hp, const int atk, 
+          const int def, const char token);
 
     /*******************************************************************************
      * enemyAttackPrep(dir) prepares an enemy attack on cell in direction dir, 
@@ -56,12 +66,12 @@ class Enemy : public Player {
     virtual void dodgesAttack(Player &attacker);
 
     /*******************************************************************************
-     * initiateTalks() determines if this enemy is interested in trading with PC
+     * initiateTalks(pc) determines if this enemy is interested in trading with pc
      * notes: non-merchants or hostile merchants are never interested
      * exceptions: if not interested, throws NotInterested()
      * time: O(1)
      * *****************************************************************************/
-    virtual void initiateTalks() const;
+    virtual void initiateTalks(const PC &pc) const;
 
     /*******************************************************************************
      * makeMove(dir) attempts to move enemy in direction dir
@@ -74,6 +84,37 @@ class Enemy : public Player {
      * *****************************************************************************/
     virtual void makeMove(const std::string dir);
 
+    /*******************************************************************************
+     * canMove() determines if this enemy ever moves on its own
+     * notes: by default, enemies wander around their chamber
+     * time: O(1)
+     * *****************************************************************************/
+    virtual bool canMove() const;
+
+    /*******************************************************************************
+     * getSpeed() gets the speed of this enemy (see TICKS_PER_TURN)
+     * notes: by default, enemies act once per action of the PC (NORMAL_SPEED)
+     * time: O(1)
+     * *****************************************************************************/
+    virtual int getSpeed() const;
+
+    /*******************************************************************************
+     * isHostileToPC(pc) determines if this enemy is currently hostile to pc
+     * notes: by default, enemies are always hostile
+     * time: O(1)
+     * *****************************************************************************/
+    virtual bool isHostileToPC(const PC &pc) const;
+
+    /*******************************************************************************
+     * moveTo(target) moves enemy to target
+     * required: target is a walkable neighbor of the enemy's location that is a
+     *           floor tile not containing an item or character (see 
+     *           Cell::enemyMoveMask())
+     * effects: changes location of enemy
+     * time: O(1)
+     * *****************************************************************************/
+    void moveTo(Cell &target);
+
     /*******************************************************************************
      * attackInDirection(dir) attempts to have enemy attack cell in direction dir
      * notes: the attack is not performed if the corresponding square is 
@@ -150,20 +191,21 @@ class Orc : public Enemy {
 
 class Merchant : public Enemy {
   const int fee;
-  static bool isHostile;
 
-  std::vector<Potion *> inventory;
+  // potions for sale; the potions and the array holding them are in the
+  // arena of the merchant's floor (see Arena)
+  Potion **inventory;
+  int numPotions;
 
   /*******************************************************************************
-   * generatePotions() fills potions with a random potions
-   * required: potions must be empty
+   * generatePotions() fills inventory with random potions
+   * required: inventory must be empty
    * time: nondeterministic 
    * *****************************************************************************/
   void generatePotions();
 
   public:
     Merchant();
-    ~Merchant();
 
     // thrown when no deal is reached with merchant
     class NoDeal : public GameException {};
@@ -172,21 +214,18 @@ class Merchant : public Enemy {
     class InvalidChoice : public GameException {};
 
     /*******************************************************************************
-     * makeHostile() makes all merchants hostile to PC
+     * makeHostile(pc) makes all merchants hostile to pc (for the rest of its game)
      * effects: adds message to pc's action
      * time: O(1) 
      * *****************************************************************************/
     static void makeHostile(PC &pc);
 
-    // resetter for isHostile
-    static void resetHostile();
-
-    // getter for hostile flag
-    static bool areMerchantsHostile();
+    // see Enemy::isHostileToPC()
+    bool isHostileToPC(const PC &pc) const;
 
     // see Enemy::initiateTalks()
     // merchants refuse to talk if hostile or with prescribed probability
-    void initiateTalks() const;
+    void initiateTalks(const PC &pc) const;
 
     /*******************************************************************************
      * printsInventory() prints merchant's potions
@@ -197,7 +236,7 @@ class Merchant : public Enemy {
     /*******************************************************************************
      * performTransaction(pc, choicem dir) gets fee from pc in exchange for potion
      *  dir indicates direction of merchant
-     * required: choice is between 'a' and 'a' + potions.size()
+     * required: choice is between 'a' and 'a' + numPotions
      * effects: updates PC's gold and action
      *          applies item to PC
      * exceptions : may throw NoDeal() or InvalidChoice()
@@ -219,6 +258,7 @@ class Merchant : public Enemy {
 };
 
 class Dragon : public Enemy {
+    // hoard the dragon guards (NULL until it is linked with one)
     DragonHoard * dh;
   public:
     Dragon();
@@ -227,6 +267,9 @@ class Dragon : public Enemy {
     // empty method (dragons don't move)
     void makeMove(const std::string dir);
 
+    // dragons never move
+    bool canMove() const;
+
     // setter for dh
     void attachDH(DragonHoard &hoard);
 
@@ -5,45 +5,96 @@
  * ****************************************************************************/
 
 #include <algorithm>
-#include <fstream>
 #include <iomanip>
 #include <cassert>
+#include <cstdlib>
+#include <functional>
 #include "floor.h"
 #include "game.h"
 #include "pc.h"
 #include "cell.h"
 #include "item.h"
+#include "layout.h"
+#include "generator.h"
 #include "constants.h"
+#include "rng.h"
+#include "arena.h"
+#include "scheduler.h"
+#include "workerPool.h"
+#include "console.h"
+#include "trace.h"
 
 using namespace std;
 using namespace constants;
 
+namespace {
+    /*******************************************************************************
+     * loadEmptyConfig(floorNum) gets the layout of floor floorNum in the empty
+     *  configuration (which compatibility mode populates instead of generating
+     *  a board)
+     * exceptions: throws GameError() if the empty configuration cannot be read
+     * time: see Layout::load()
+     * *****************************************************************************/
+    const Layout& loadEmptyConfig(const int floorNum) {
+        try {
+            return Layout::load(EMPTY_CONFIG, floorNum);
+        } catch (InvalidFile &e) {
+            cerr << "Cannot read the empty configuration: " << EMPTY_CONFIG << endl;
+            throw GameError();
+        } // catch
+    } // loadEmptyConfig()
+
+    /*******************************************************************************
+     * chamberWorkers(numThreads) gets the threads helping to play the chambers,
+     *  shared by every floor
+     * notes: the workers are started on the first call, and stopped at exit
+     * time: O(numThreads) on the first call, O(1) afterwards
+     * *****************************************************************************/
+    WorkerPool& chamberWorkers(const int numThreads) {
+        static WorkerPool workers(numThreads - 1);
+        return workers;
+    } // chamberWorkers()
+} // namespace
+
 // see floor.h for details
 Cell& Floor::randFloorTile(const int notIn) const{
-    assert(-1 <= notIn && notIn <= NUM_CHAMBERS);
+    const int numChambers = layout->getNumChambers();
+    assert(-1 <= notIn && notIn <= numChambers);
+    if (numChambers == 0) {
+        cerr << "Configuration contains no chambers." << endl;
+        throw GameError();
+    } // if
 
     // gets random chamber number, avoiding notIn
     int chamberNum;
     do {
-        chamberNum = rand() % NUM_CHAMBERS;
-    } while (chamberNum == notIn);
+        chamberNum = Rng::current().next() % numChambers;
+    } while (chamberNum == notIn && numChambers > 1);
 
     // number of failed attempts to find empty tile
     int failedAttempts = 0;
     // gets random empty floor tile in this chamber
     // after MAX_CHAMBER_LOAD attempts, tries another chamber
     while (1) {
-        const int r = rand() % NUM_ROWS;
-        const int c = rand() % NUM_COLS;
-        if (floor[r][c]->getChamberNum() == chamberNum
-            && floor[r][c]->isFloorTile() && !floor[r][c]->isOccupiedByCharacter()
-            && !floor[r][c]->containsItem()) {
-                return *(floor[r][c]);
+        int r, c;
+        if (options->compat) {
+            r = Rng::current().next() % numRows;
+            c = Rng::current().next() % numCols;
+        } else {
+            const vector<int> &tiles = layout->getChamberTiles(chamberNum);
+            const int tile = tiles[Rng::current().next() % tiles.size()];
+            r = tile / numCols;
+            c = tile % numCols;
+        } // if
+        if (floorTiles.test(r, c) && !enemyCells.test(r, c) && !pcCell.test(r, c)
+            && !itemCells.test(r, c) && layout->getChamberNum(r, c) == chamberNum) {
+                return *getCell(r, c);
         } // if
         ++failedAttempts;
-        if (failedAttempts == MAX_CHAMBER_LOAD) {
+        if (failedAttempts % MAX_CHAMBER_LOAD == 0 && (failedAttempts == MAX_CHAMBER_LOAD 
+                                                       || !options->compat)) {
             // this chamber is quite full so tries the next one
-            chamberNum = (chamberNum + 1) % NUM_CHAMBERS;
+            chamberNum = (chamberNum + 1) % numChambers;
         } // if
     } // while
 } // randFloorTile()
@@ -53,7 +104,9 @@ void Floor::populate(PC &pc) {
     // randomly places player and stairs in different chambers
     Cell& pcLocation = randFloorTile();
     pcLocation.characterMovesIn(pc);
-    randFloorTile(pcLocation.getChamberNum()).setStairs();
+    Cell &stairsLocation = randFloorTile(pcLocation.getChamberNum());
+    stairsLocation.setStairs();
+    stairs = &stairsLocation;
 
     // randomly places potions
     for (int i =0; i < NUM_POTION_PER_FLOOR; ++i) {
@@ -84,8 +137,9 @@ void Floor::populate(PC &pc) {
     // randomly places enemies; # enemies increases per floor
     const int numEnemiesThisFloor = NUM_ENEMIES_PER_FLOOR + floorNum * 2;
     for (int i =0; i < numEnemiesThisFloor; ++i) {
-        enemies.push_back(createEnemy());
-        randFloorTile().characterMovesIn(*enemies.back());
+        Enemy *e = createEnemy();
+        addEnemy(*e);
+        randFloorTile().characterMovesIn(*e);
     } // for
 } // populate()
 
@@ -93,73 +147,138 @@ void Floor::populate(PC &pc) {
 void Floor::linkDragons (){
     // links every dragon
     for (vector<Dragon *>::iterator it = dragons.begin(); it != dragons.end(); ++it) {
-        // tries to find dragon hoard in 1 block radius
-        for (vector<string>::const_iterator iter = DIRECTIONS.begin(); iter != DIRECTIONS.end(); ++iter) {
-            Cell * target = (*it)->getLocation()->getNeighbor(*iter);
-
-            // if no walkable tile in this direction, try next direction
-            if (!target) continue;
-
-            // if there is a dragon hoard in this cell, search is over
-            DragonHoard * dh = (DragonHoard *) target->getItem();
-            if (dh) {                
-                // links dragon and dragon hoard
-                (*it)->attachDH(*dh);
-                dh->attachDragon(**it);
-                break;
-            } // if
-            if (iter + 1 == DIRECTIONS.end()) {
-                // the search must be successful
-                cerr << "Configuration file contains Dragon not beside a Dragon Hoard." << endl;
-                throw GameError();
-            } // if
-        } // for
+        // gets the dragon hoard the layout found for the dragon (in 1 block radius)
+        const Cell *location = (*it)->getLocation();
+        const int hoard = layout->getHoard(location->getRow(), location->getCol());
+        const Cell *target = hoard == -1 ? NULL : getCell(hoard / numCols, hoard % numCols);
+        DragonHoard *dh = target ? dynamic_cast<DragonHoard *>(target->getItem()) : NULL;
+
+        // the search must be successful
+        if (!dh || dh->isGuarded()) {
+            cerr << "Configuration file contains Dragon not beside a Dragon Hoard." << endl;
+            throw GameError();
+        } // if
+
+        // links dragon and dragon hoard
+        (*it)->attachDH(*dh);
+        dh->attachDragon(**it);
     } // for
     // clears list of dragons to be linked
     dragons.clear();
 } // linkDragons()
 
 // see floor.h for details
-Floor::Floor(const int floorNum, const string filename, PC &pc) : floorNum(floorNum), pc(pc) {
-    ifstream in (filename.c_str());
-    if (!in.good()) {
-        cout << "Invalid file. Will use random configuration." << endl;
-        in.close();
-        in = ifstream (EMPTY_CONFIG.c_str());
-    } // if      
-
-    // reads config char-by-char
-    floor = new Cell ** [NUM_ROWS];
-    for (int row = 0; row < NUM_ROWS; ++row) {
-        floor[row] = new Cell * [NUM_COLS];
-        char ch;
-        for (int col = 0; col < NUM_COLS; ++col) {
-            ch = in.get(); 
-
-            // determines chamberNum
-            const int chamberNum = findChamberNum(row, col); 
-            floor[row][col] = new Cell (row, col, chamberNum, ch, pc, *this);
+Floor::Floor(const int floorNum, const string filename, PC &pc, const GameOptions &options) : 
+                generatedLayout(NULL), generator(0), layout(NULL), numRows(0), numCols(0), 
+                numChunkCols(0), floorTiles(0, 0), enemyCells(0, 0), 
+                itemCells(0, 0), pcCell(0, 0), stairs(NULL), floorNum(floorNum), session(0), pc(&pc), entered(false), 
+                options(&options), deferringChanges(false), pcDistance(0, 0) {
+    try {
+        reset(floorNum, filename, pc, options);
+    } catch (...) {
+        // (the destructor does not run if the constructor throws)
+        clearOccupants();
+        freeCells();
+        delete generatedLayout;
+        throw;
+    } // catch
+} // Floor ctor
+
+// see floor.h for details
+void Floor::reset(const int floorNum, const string &filename, PC &pc, const GameOptions &options) {
+    clearOccupants();
+    this->floorNum = floorNum;
+    session = Trace::session();
+    this->pc = &pc;
+    this->options = &options;
+    entered = false;
+    notices.clear();
+
+    // the items of the previous floor go with the arena; the items of this
+    // one are allocated from it while it is built
+    arena.release();
+    Arena::use(&arena);
+    try {
+        build(filename);
+    } catch (...) {
+        Arena::use(NULL);
+        throw;
+    } // catch
+    Arena::use(NULL);
+} // reset()
+
+// see floor.h for details
+void Floor::build(const string &filename) {
+    // reads the layout from filename, unless the floor is random (or filename
+    // cannot be read, which makes it random)
+    bool random = filename == EMPTY_CONFIG;
+    if (!random) {
+        try {
+            layout = &Layout::load(filename, floorNum);
+        } catch (InvalidFile &e) {
+            notices += "Invalid file. Will use random configuration.\n";
+            random = true;
+        } // catch
+    } // if
+
+    // generates a new layout for random floors (populating the empty 
+    // configuration instead in compatibility mode)
+    if (random && !options->compat) {
+        generator.seed(Rng::current().next());
+        generator.generate(generatedRows);
+        if (generatedLayout) generatedLayout->assign(generatedRows);
+        else generatedLayout = new Layout(generatedRows);
+        layout = generatedLayout;
+    } else if (random) {
+        layout = &loadEmptyConfig(floorNum);
+    } // else if
+    stairs = NULL;
+
+    // cells can only be reused if the board has the same dimensions
+    if (layout->getNumRows() != numRows || layout->getNumCols() != numCols) {
+        freeCells();
+        numRows = layout->getNumRows();
+        numCols = layout->getNumCols();
+        numChunkCols = (numCols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        chunks.assign(((numRows + CHUNK_SIZE - 1) / CHUNK_SIZE) * numChunkCols, NULL);
+    } // if
+    floorTiles.resize(numRows, numCols);
+    enemyCells.resize(numRows, numCols);
+    itemCells.resize(numRows, numCols);
+    pcCell.resize(numRows, numCols);
+    pcDistance.resize(numRows, numCols);
+
+    // allocates the chunks that are not only empty space
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            Cell **&chunk = chunks[(row / CHUNK_SIZE) * numChunkCols + col / CHUNK_SIZE];
+            if (!chunk && layout->at(row, col) != ' ') chunk = new Cell * [CHUNK_SIZE * CHUNK_SIZE]();
         } // for
-        ch = in.get(); // skip new line
     } // for
-    in.close();
-
-    // stores neighbors for walkable tiles
-    for (int row = 0; row < NUM_ROWS; ++row) {
-        for (int col = 0; col < NUM_COLS; ++col) {
-            if (floor[row][col]->isWalkableTile()) {
-                // look at 8 possible directions
-                for (map<const string, pair<const int, const int> >::const_iterator 
-                        it = DIRECTION_TO_OFFSET.begin(); it != DIRECTION_TO_OFFSET.end(); ++it) {
-                    const int neighbRow = row + it->second.first;
-                    const int neighbCol = col + it->second.second;
-                    // if the neighbor's coordinates are within bounds and is walkable, adds the neighbor 
-                    if (0 <= neighbRow && 0 <= neighbCol && neighbRow < NUM_ROWS && neighbCol < NUM_COLS
-                        && floor[neighbRow][neighbCol]->isWalkableTile()) {
-                        floor[row][col]->addNeighbor(it->first, *(floor[neighbRow][neighbCol]));
-                    } // if
-                } // for
-            } // if
+
+    // creates (or resets) a cell for every configuration character in those 
+    // chunks (row by row, so that enemies take their turns in reading order)
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            Cell **chunk = chunks[(row / CHUNK_SIZE) * numChunkCols + col / CHUNK_SIZE];
+            if (!chunk) continue;
+            Cell *&cell = chunk[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+            if (cell) cell->reset(layout->getChamberNum(row, col), layout->at(row, col), *pc);
+            else cell = new Cell (row, col, layout->getChamberNum(row, col), layout->at(row, col), *pc, *this);
+        } // for
+    } // for
+
+    // stores neighbors for walkable tiles (as the layout found them)
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            const int neighbors = layout->getNeighbors(row, col);
+            Cell *cell = neighbors ? getCell(row, col) : NULL;
+            if (!cell) continue;
+            for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+                if (!(neighbors & (1 << dir))) continue;
+                Cell *neighbor = getCell(row + ROW_OFFSETS[dir], col + COL_OFFSETS[dir]);
+                if (neighbor) cell->addNeighbor(dir, *neighbor);
+            } // for
         } // for
     } // for
 
@@ -167,29 +286,102 @@ Floor::Floor(const int floorNum, const string filename, PC &pc) : floorNum(floor
     linkDragons();
 
     // randomly populates the floor if the initial configuration was empty
-    if (filename == EMPTY_CONFIG) populate(pc);
-} // Floor ctor
+    if (random) {
+        TraceSpan span("populate", floorNum, session);
+        populate(*pc);
+    } // if
+    if (pcCell.count() != 1) {
+        cerr << "Configuration file must contain exactly one Player Character." << endl;
+        throw GameError();
+    } // if
+
+    // sorts the enemies by chamber; they are all awake to begin with
+    chamberEnemies.resize(max((int) chamberEnemies.size(), layout->getNumChambers()));
+    for (size_t i = 0; i < chamberEnemies.size(); ++i) chamberEnemies[i].clear();
+    for (vector<Enemy *>::iterator it = enemies.begin(); it != enemies.end(); ++it) {
+        chamberEnemies[(*it)->getLocation()->getChamberNum()].push_back(*it);
+    } // for
+    awakeChamber = -1;
+    enemiesSleep = !options->compat && !options->exact && (int) enemies.size() >= MIN_SLEEPING_ENEMIES;
+
+    // seeds the streams of the chambers from the floor's stream
+    chamberStreams.resize(chamberEnemies.size());
+    chamberTurns.resize(chamberEnemies.size());
+    chamberChanges.resize(chamberEnemies.size());
+    if (!options->compat) {
+        const unsigned int high = Rng::current().next();
+        const unsigned int seed = (high << 16) ^ Rng::current().next();
+        for (size_t i = 0; i < chamberStreams.size(); ++i) {
+            chamberStreams[i].seed(Rng::substream(seed, i));
+        } // for
+    } // if
+} // build()
 
 // see floor.h for details
-Floor::~Floor() {
-    // delete enemies
+void Floor::clearOccupants() {
     for(vector<Enemy *>::iterator it = enemies.begin(); it != enemies.end(); ++it) {
         delete (*it);
     } // for
+    enemies.clear();
+    dragons.clear();
+    scheduler.clear();
+} // clearOccupants()
 
-    // delete cells
-    for (int row = 0; row < NUM_ROWS; ++row) {
-        for (int col = 0; col < NUM_COLS; ++col) {
-            delete floor[row][col];
-        } // for
-        delete [] floor[row];
+// see floor.h for details
+void Floor::freeCells() {
+    for (vector<Cell **>::iterator it = chunks.begin(); it != chunks.end(); ++it) {
+        if (!*it) continue;
+        for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i) delete (*it)[i];
+        delete [] *it;
     } // for
-    delete [] floor;
+    chunks.clear();
+} // freeCells()
+
+// see floor.h for details
+Floor::~Floor() {
+    clearOccupants();
+    freeCells();
+    delete generatedLayout;
 } // Floor dtor
 
+// see floor.h for details
+void Floor::enter() {
+    assert(!entered);
+    entered = true;
+    Arena::use(&arena);
+    int row, col;
+    if (pcCell.first(row, col)) pc->setLocation(getCell(row, col));
+    Console::out() << notices;
+    notices.clear();
+} // enter()
+
+// see floor.h for details
+bool Floor::isEntered() const {
+    return entered;
+} // isEntered()
+
+// see floor.h for details
+int Floor::getNumRows() const {
+    return numRows;
+} // getNumRows()
+
+// see floor.h for details
+int Floor::getNumCols() const {
+    return numCols;
+} // getNumCols()
+
+// see floor.h for details
+Cell* Floor::getCell(const int row, const int col) const {
+    if (row < 0 || col < 0 || row >= numRows || col >= numCols) return NULL;
+    Cell **chunk = chunks[(row / CHUNK_SIZE) * numChunkCols + col / CHUNK_SIZE];
+    if (!chunk) return NULL;
+    return chunk[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+} // getCell()
+
 // see floor.h for details
 void Floor::addEnemy (Enemy &e){
     enemies.push_back(&e);
+    scheduler.add(e);
 } // addEnemy()
 
 // see floor.h for details
@@ -200,65 +392,354 @@ void Floor::addDragon (Dragon &d){
 // see floor.h for details
 void Floor::removeEnemy(const Enemy &e){
     enemies.erase(remove(enemies.begin(), enemies.end(), &e), enemies.end());
+    vector<Enemy *> &chamber = chamberEnemies[e.getLocation()->getChamberNum()];
+    chamber.erase(remove(chamber.begin(), chamber.end(), &e), chamber.end());
+    scheduler.remove(e);
 } // removeEnemies()
 
+// see floor.h for details
+int Floor::chooseMove(const Enemy &e) const {
+    if (options->compat) {
+        // original behaviour: draws random directions from a shrinking list
+        // until a valid one is found; enemies that never move accept the first
+        const unsigned int mask = e.canMove() ? e.getLocation()->enemyMoveMask() 
+                                              : (1u << NUM_DIRECTIONS) - 1;
+        int remaining[NUM_DIRECTIONS];
+        for (int i = 0; i < NUM_DIRECTIONS; ++i) remaining[i] = i;
+        for (int size = NUM_DIRECTIONS; size > 0; --size) {
+            const int index = Rng::current().next() % size;
+            if (mask & (1u << remaining[index])) return remaining[index];
+            // if move is invalid, remove from list and try again
+            for (int i = index; i + 1 < size; ++i) remaining[i] = remaining[i + 1];
+        } // for
+        return -1;
+    } // if
+
+    if (!e.canMove()) return -1;
+    const unsigned int mask = e.getLocation()->enemyMoveMask();
+    if (!mask) return -1;
+
+    // picks the k-th valid direction
+    int numValid = 0;
+    for (unsigned int m = mask; m; m &= m - 1) ++numValid;
+    int k = Rng::current().next() % numValid;
+    for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+        if ((mask & (1u << dir)) && k-- == 0) return dir;
+    } // for
+    assert(false);
+    return -1;
+} // chooseMove()
 
 // see floor.h for details
 void Floor::turnEnemies(){
-    // each enemy gets a turn
-    for (vector<Enemy *>::iterator it = enemies.begin(); it != enemies.end(); ++it) {
-        // has this enemy attacked the PC this turn?
-        bool enemyAttacked = false;
+    // in hard mode, measures distances from the PC's new location once for everyone
+    if (options->hard) pcDistance.setSource(*pc->getLocation());
 
-        // enemy tries to attack PC in any direction
-        for (vector<string>::const_iterator iter = DIRECTIONS.begin(); iter != DIRECTIONS.end(); ++iter) {
-            try {
-                (*it)->attackInDirection(*iter);
-                enemyAttacked = true;
-                break;  
-            } catch (UnwalkableCell &e) {
-            } catch (UnoccupiedCell &e) {
-            } catch (PCNotInCell &e) {
-            } catch (Enemy::NotHostile &e) {
-            } catch (Player::AttackDodged &e) {
-                enemyAttacked = true;
-                break;
-            } // catch
+    // wakes the enemies the PC has come next to
+    for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+        Cell *neighbor = pc->getLocation()->getNeighbor(dir);
+        if (neighbor && neighbor->getEnemy()) scheduler.wake(*neighbor->getEnemy());
+    } // for
+
+    // wakes the enemies that are no longer away from the PC
+    if (enemiesSleep) wakeNearPC();
+
+    // in compat mode, each enemy that is due acts in turn, until the PC's next turn
+    const int until = scheduler.getTime() + TICKS_PER_TURN;
+    if (options->compat) {
+        while (Enemy *enemy = scheduler.next(until)) act(*enemy);
+        return;
+    } // if
+
+    // otherwise, finds the chambers next to the PC (including its own)
+    pcChambers.clear();
+    const Cell &pcLocation = *pc->getLocation();
+    if (pcLocation.getChamberNum() != -1) pcChambers.push_back(pcLocation.getChamberNum());
+    for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+        const Cell *neighbor = pcLocation.getNeighbor(dir);
+        if (!neighbor || neighbor->getChamberNum() == -1) continue;
+        if (find(pcChambers.begin(), pcChambers.end(), neighbor->getChamberNum()) 
+            == pcChambers.end()) pcChambers.push_back(neighbor->getChamberNum());
+    } // for
+
+    // and sorts the enemies that are due by chamber
+    while (Enemy *enemy = scheduler.next(until)) {
+        // enemies that never move have nothing to do away from the PC, so they
+        // sleep until it comes near
+        const Cell &location = *enemy->getLocation();
+        if (!enemy->canMove() && !pcCell.anyInNeighborhood(location.getRow(), location.getCol())) {
+            scheduler.park(*enemy);
+            continue;
+        } // if
+
+        // enemies away from the PC sleep until it comes near (see wakeNearPC())
+        if (enemiesSleep && isDormant(*enemy)) {
+            scheduler.park(*enemy);
+            continue;
+        } // if
+
+        const int chamberNum = location.getChamberNum();
+        if (find(pcChambers.begin(), pcChambers.end(), chamberNum) != pcChambers.end()) {
+            pcTurns.push_back(enemy);
+        } else {
+            if (chamberTurns[chamberNum].empty()) busyChambers.push_back(chamberNum);
+            chamberTurns[chamberNum].push_back(enemy);
+        } // else
+    } // while
+    playChambers();
+} // turnEnemies()
+
+// see floor.h for details
+void Floor::act(Enemy &e) {
+    TraceSpan span("enemy", floorNum, session);
+    // enemy tries to attack PC in any direction, if PC is in its 1 block radius
+    const Cell &location = *e.getLocation();
+    const bool nearPC = pcCell.anyInNeighborhood(location.getRow(), location.getCol());
+    for (vector<string>::const_iterator iter = DIRECTIONS.begin(); 
+            nearPC && iter != DIRECTIONS.end(); ++iter) {
+        try {
+            e.attackInDirection(*iter);
+            // if attacked succeeded, enemy's turn is over
+            return;
+        } catch (UnwalkableCell &ex) {
+        } catch (UnoccupiedCell &ex) {
+        } catch (PCNotInCell &ex) {
+        } catch (Enemy::NotHostile &ex) {
+        } catch (Player::AttackDodged &ex) {
+            // so is it if the attack was dodged
+            return;
+        } // catch
+    } // for
+
+    // in hard mode, hostile enemies step towards the PC if possible
+    if (options->hard && e.canMove() && e.isHostileToPC(*pc)) {
+        Cell &location = *e.getLocation();
+        const int dir = pcDistance.downhill(location, location.enemyMoveMask());
+        if (dir != -1) {
+            e.moveTo(*location.getNeighbor(dir));
+            return;
+        } // if
+    } // if
+
+    // moves in a random valid direction, if any
+    const int dir = chooseMove(e);
+    if (dir != -1 && e.canMove()) e.moveTo(*(e.getLocation()->getNeighbor(dir)));
+} // act()
+
+// see floor.h for details
+void Floor::actInOrder(const vector<Enemy *> &turns) {
+    Rng &previous = Rng::current();
+    try {
+        for (vector<Enemy *>::const_iterator it = turns.begin(); it != turns.end(); ++it) {
+            Rng::use(&chamberStreams[(*it)->getLocation()->getChamberNum()]);
+            act(**it);
         } // for
+    } catch (...) {
+        Rng::use(&previous);
+        throw;
+    } // catch
+    Rng::use(&previous);
+} // actInOrder()
 
-        // if attacked succeeded or was dodged, enemy's turn is over; otherwise, enemy moves
-        if (enemyAttacked) continue;
+// see floor.h for details
+void Floor::playChambers() {
+    // task 0 plays the chambers next to the PC, task i > 0 chamber busyChambers[i - 1]
+    const function<void(int)> task = [this](const int i) {
+        actInOrder(i ? chamberTurns[busyChambers[i - 1]] : pcTurns);
+    };
+    const int numTasks = busyChambers.size() + 1;
+    int numActing = pcTurns.size();
+    for (vector<int>::const_iterator it = busyChambers.begin(); it != busyChambers.end(); ++it) {
+        numActing += chamberTurns[*it].size();
+    } // for
 
-        // keep trying random moves until one is valid or list of available moves is exhausted
-        vector<string> options = DIRECTIONS;
-        do {
-            // choose random direction
-            const int index = rand() % options.size();
-            try {
-                (*it)->makeMove(options.at(index));
-                // if move was successful, then moving turn is done
-                break;
-            } catch (InvalidMove &e) {
-                // if move is invalid, remove from list and try again
-                options.erase(options.begin() + index);
-            } // catch
-        } while (!options.empty());
+    deferringChanges = true;
+    try {
+        if (options->threads > 1 && numTasks > 1 && numActing >= MIN_PARALLEL_ENEMIES) {
+            chamberWorkers(options->threads).run(numTasks, task);
+        } else {
+            // the chambers next to the PC go last, so that the others still act
+            // if the PC is slain
+            for (int i = numTasks - 1; i >= 0; --i) task(i);
+        } // else
+    } catch (...) {
+        applyChanges();
+        throw;
+    } // catch
+    applyChanges();
+} // playChambers()
+
+// see floor.h for details
+void Floor::applyChanges() {
+    deferringChanges = false;
+    for (size_t i = 0; i < chamberChanges.size(); ++i) {
+        vector<const Cell *> &changes = chamberChanges[i];
+        for (vector<const Cell *>::const_iterator it = changes.begin(); it != changes.end(); ++it) {
+            cellChanged(**it);
+        } // for
+        changes.clear();
     } // for
-} // turnEnemies()
+    for (vector<int>::const_iterator it = busyChambers.begin(); it != busyChambers.end(); ++it) {
+        chamberTurns[*it].clear();
+    } // for
+    busyChambers.clear();
+    pcTurns.clear();
+} // applyChanges()
+
+// see floor.h for details
+bool Floor::isDormant(const Enemy &e) const {
+    const Cell &location = *e.getLocation(), &pcLocation = *pc->getLocation();
+    if (location.getChamberNum() == pcLocation.getChamberNum()) return false;
+    return abs(location.getRow() - pcLocation.getRow()) > options->wakeRadius
+        || abs(location.getCol() - pcLocation.getCol()) > options->wakeRadius;
+} // isDormant()
+
+// see floor.h for details
+void Floor::wakeNearPC() {
+    const Cell &location = *pc->getLocation();
+
+    // wakes the enemies of the chamber the PC has entered
+    const int chamberNum = location.getChamberNum();
+    if (chamberNum != awakeChamber && chamberNum != -1) {
+        const vector<Enemy *> &chamber = chamberEnemies[chamberNum];
+        for (vector<Enemy *>::const_iterator it = chamber.begin(); it != chamber.end(); ++it) {
+            wake(**it);
+        } // for
+    } // if
+    awakeChamber = chamberNum;
+
+    // and the enemies within the radius
+    const int radius = options->wakeRadius;
+    const int lastRow = min(location.getRow() + radius, numRows - 1);
+    const int lastCol = min(location.getCol() + radius, numCols - 1);
+    for (int row = max(location.getRow() - radius, 0); row <= lastRow; ++row) {
+        for (int col = max(location.getCol() - radius, 0); col <= lastCol; ++col) {
+            if (enemyCells.test(row, col)) wake(*getCell(row, col)->getEnemy());
+        } // for
+    } // for
+} // wakeNearPC()
+
+// see floor.h for details
+void Floor::wake(Enemy &e) {
+    if (!scheduler.isParked(e) || !e.canMove()) return;
+    // the enemy was parked instead of taking an action, which it missed too
+    Rng &previous = Rng::current();
+    Rng::use(&chamberStreams[e.getLocation()->getChamberNum()]);
+    catchUp(e, scheduler.wake(e) + 1);
+    Rng::use(&previous);
+} // wake()
+
+// see floor.h for details
+void Floor::catchUp(Enemy &e, const int missed) {
+    // in hard mode, hostile enemies kept stepping towards the PC
+    if (options->hard && e.isHostileToPC(*pc)) {
+        for (int i = 0; i < missed && i < CATCH_UP_MIXING_MOVES; ++i) {
+            Cell &location = *e.getLocation();
+            const int dir = pcDistance.downhill(location, location.enemyMoveMask());
+            if (dir == -1) break;
+            e.moveTo(*location.getNeighbor(dir));
+        } // for
+        return;
+    } // if
+
+    // after enough random moves, the enemy could be anywhere in its chamber
+    if (missed >= CATCH_UP_MIXING_MOVES) {
+        const vector<int> &tiles = layout->getChamberTiles(e.getLocation()->getChamberNum());
+        for (int attempt = 0; attempt < MAX_CHAMBER_LOAD; ++attempt) {
+            const int tile = tiles[Rng::current().next() % tiles.size()];
+            const int r = tile / numCols, c = tile % numCols;
+            if (floorTiles.test(r, c) && !enemyCells.test(r, c) && !pcCell.test(r, c)
+                && !itemCells.test(r, c)) {
+                e.getLocation()->enemyMovesOut();
+                getCell(r, c)->characterMovesIn(e);
+                return;
+            } // if
+        } // for
+        return;
+    } // if
+
+    // otherwise, makes the moves it missed
+    for (int i = 0; i < missed; ++i) {
+        const int dir = chooseMove(e);
+        if (dir == -1) break;
+        e.moveTo(*e.getLocation()->getNeighbor(dir));
+    } // for
+} // catchUp()
+
+// see floor.h for details
+void Floor::cellChanged(const Cell &c) {
+    // the layers are shared by the chambers, so they are updated afterwards
+    if (deferringChanges) {
+        assert(c.getChamberNum() != -1);
+        chamberChanges[c.getChamberNum()].push_back(&c);
+        return;
+    } // if
+
+    const int row = c.getRow(), col = c.getCol();
+    if (c.isFloorTile()) floorTiles.set(row, col); 
+    else floorTiles.reset(row, col);
+    if (c.getEnemy()) enemyCells.set(row, col); 
+    else enemyCells.reset(row, col);
+    if (c.containsItem()) itemCells.set(row, col); 
+    else itemCells.reset(row, col);
+    if (c.isOccupiedByPC()) pcCell.set(row, col); 
+    else pcCell.reset(row, col);
+} // cellChanged()
+
+// see floor.h for details
+const Bitboard& Floor::getPCCell() const {
+    return pcCell;
+} // getPCCell()
 
 // see floor.h for details
 ostream& operator<< (ostream& out, const Floor &f) {
-    // prints floor config
-    for (int row = 0; row < constants::NUM_ROWS; ++row) {
-        for (int col = 0; col < constants::NUM_COLS; ++col) {
-            out << * (f.floor[row][col]);
+    // chooses the window to print, centred on the PC on large boards
+    const int height = min(f.numRows, VIEWPORT_ROWS);
+    const int width = min(f.numCols, VIEWPORT_COLS);
+    int top = 0, left = 0;
+    const Cell *location = f.pc->getLocation();
+    if (location) {
+        top = max(0, min(location->getRow() - height / 2, f.numRows - height));
+        left = max(0, min(location->getCol() - width / 2, f.numCols - width));
+    } // if
+
+    // copies the window of the background (at once if it is as wide as the board)
+    const string &background = f.layout->getBackground();
+    const int stride = width + 1;
+    f.frame.resize(height * stride);
+    if (width == f.numCols) {
+        const string::const_iterator start = background.begin() + top * stride;
+        copy(start, start + height * stride, f.frame.begin());
+    } else {
+        for (int row = 0; row < height; ++row) {
+            const string::const_iterator start = background.begin() + (top + row) * (f.numCols + 1) + left;
+            copy(start, start + width, f.frame.begin() + row * stride);
+            f.frame[row * stride + width] = '\n';
+        } // for
+    } // else
+
+    // writes the occupants and stairs in the window over it
+    const Bitboard *occupied[] = {&f.enemyCells, &f.itemCells, &f.pcCell};
+    for (int i = 0; i < 3; ++i) {
+        int row, col;
+        for (bool found = occupied[i]->first(row, col); found; found = occupied[i]->next(row, col)) {
+            if (row < top || row >= top + height || col < left || col >= left + width) continue;
+            f.frame[(row - top) * stride + col - left] = f.getCell(row, col)->getToken();
         } // for
-        out << endl;
     } // for
-    out << right << setw(constants::NUM_COLS/2) << "Floor " << f.floorNum << endl;
+    if (f.stairs) {
+        const int row = f.stairs->getRow(), col = f.stairs->getCol();
+        if (row >= top && row < top + height && col >= left && col < left + width) {
+            f.frame[(row - top) * stride + col - left] = f.stairs->getToken();
+        } // if
+    } // if
+
+    // prints floor config
+    out.write(f.frame.data(), f.frame.size());
+    out << right << setw(VIEWPORT_COLS/2) << "Floor " << f.floorNum << endl;
 
     // prints PC stats and action
-    out << f.pc;
+    out << *f.pc;
 
     return out;
-} // operator<< (ostream&, Floor&)
\ No newline at end of file
+} // operator<< (ostream&, Floor&)
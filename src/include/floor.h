@@ -3,21 +3,114 @@
 #include <vector>
 #include <string>
 #include "enemy.h"
+#include "flowField.h"
+#include "bitboard.h"
+#include "generator.h"
+#include "arena.h"
+#include "scheduler.h"
+#include "rng.h"
 
 class Cell;
 class PC;
+class Layout;
 
 class Floor {
-    // grid of cells
-    Cell*** floor;
+    // messages to print when the PC enters the floor
+    // (declared first, since building the floor may add to them)
+    std::string notices;
 
-    const int floorNum;
+    // layout generated for this floor (NULL if none has been generated yet;
+    // kept for reuse when the floor is reset)
+    Layout *generatedLayout;
 
-    PC &pc;
+    // storage of the items on the floor (including merchants' potions), 
+    // released all at once when the floor is reset or freed
+    Arena arena;
+
+    // generator of the layout and its rows (kept for reuse)
+    Generator generator;
+    std::vector<std::string> generatedRows;
+
+    // configuration the floor was built from
+    const Layout *layout;
+
+    // dimensions of the board
+    int numRows, numCols;
+
+    // number of chunks in every row of chunks
+    int numChunkCols;
+
+    // cells, in CHUNK_SIZE x CHUNK_SIZE chunks stored row by row; each chunk
+    // stores its cells row by row (NULL for chunks of only empty space)
+    std::vector<Cell **> chunks;
+
+    // occupancy layers, one bit per cell, kept up to date by the cells
+    Bitboard floorTiles;
+    Bitboard enemyCells;
+    Bitboard itemCells;
+    Bitboard pcCell;
+
+    // stairs placed on the floor (NULL if they are part of the layout, and 
+    // so of its background)
+    const Cell *stairs;
+
+    // board as last printed: the layout's background, with the occupants 
+    // written over it (kept to avoid reallocations)
+    mutable std::string frame;
+
+    int floorNum;
+
+    // session the floor is played in (see Trace)
+    int session;
+
+    PC *pc;
+
+    // has the PC entered the floor? (floors may be built before the PC 
+    // leaves the previous one)
+    bool entered;
+
+    // options for the game being played
+    const GameOptions *options;
     
     // enemies remaining on the floor (including dragons)
     std::vector<Enemy *> enemies;
 
+    // when the enemies act
+    Scheduler scheduler;
+
+    // enemies of every chamber (enemies never leave their chamber)
+    std::vector<std::vector<Enemy *> > chamberEnemies;
+
+    // chamber whose enemies were last woken up by the PC (-1 if none)
+    int awakeChamber;
+
+    // whether enemies away from the PC sleep (see isDormant()): except in 
+    // exact (or compat) mode, on floors built with MIN_SLEEPING_ENEMIES enemies
+    bool enemiesSleep;
+
+    // random stream of every chamber, which its enemies draw from (except in
+    // compat mode), so that the chambers play out independently
+    std::vector<Rng> chamberStreams;
+
+    // chambers next to the PC, whose enemies may attack it (see turnEnemies())
+    std::vector<int> pcChambers;
+
+    // enemies due to act this turn in the chambers next to the PC, in order
+    std::vector<Enemy *> pcTurns;
+
+    // enemies due to act this turn in every other chamber, in order, and the 
+    // chambers that have any
+    std::vector<std::vector<Enemy *> > chamberTurns;
+    std::vector<int> busyChambers;
+
+    // cells changed while the chambers are played at once, by chamber, and
+    // whether they are being played (see cellChanged())
+    std::vector<std::vector<const Cell *> > chamberChanges;
+    bool deferringChanges;
+
+    // distances to the PC, shared by the enemies chasing it (hard mode only)
+    FlowField pcDistance;
+
     // dragons remaining on the floor
     // (to be used only while floor is constructed; this is empty during game play)
     std::vector<Dragon *> dragons;
@@ -25,18 +118,22 @@ class Floor {
     /*******************************************************************************
      * randFloorTile() randomly chooses an empty floor tile; the optional parameter
      *    notIn indicates (if not -1) which chamber to avoid
-     * required: notIn must be one of -1, 0, ..., NUM_CHAMBERS
+     * required: notIn must be one of -1, 0, ..., number of chambers
      * notes: each chamber other than notIn is equally likely, 
      *        each floor tile in a chamber is equally likely
-     * required: srand() must have been called
+     *        notIn is ignored if the floor has a single chamber
+     *        in compat mode, reproduces the original sequence of draws
+     *        (random tiles anywhere on the board until one is in the chamber)
+     *        draws from the current random stream (see Rng::current())
+     * exceptions: throws GameError() if the floor has no chambers
      * time: nondeterministic, O(1) expected
      * *****************************************************************************/
     Cell& randFloorTile(const int notIn = -1) const;
 
     /*******************************************************************************
      * populates(pc) randomly populates the floor with pc, enemies, gold, potions
-     * required: srand() must have been called
-     *           floor must be empty [not checked]
+     * notes: draws from the current random stream (see Rng::current())
+     * required: floor must be empty [not checked]
      * time: nondeterministic, O(#enemies + #potions + #gold per floor) expected
      * *****************************************************************************/
     void populate(PC &pc);
@@ -45,27 +142,181 @@ class Floor {
      * linkDragons() links existing Dragons with Dragon Hoards
      * notes: to be called once, immediately after floor is built from file
      *        from configuration file
-     * effects: links Dragons with any nearby Dragon Hoards
-     * time : O(#dragons)
+     * effects: links Dragons with the nearby Dragon Hoards the layout found for
+     *          them (see Layout::getHoard())
+     * exceptions: throws GameError() if a Dragon has no Dragon Hoard
+     * time : O(#dragons * log #dragons)
      * *****************************************************************************/
     void linkDragons ();
 
+    /*******************************************************************************
+     * chooseMove(e) randomly chooses a direction for e to move in
+     * notes: returns the index in DIRECTIONS of the chosen direction, or -1 if
+     *        e cannot move
+     *        each valid direction is equally likely and is chosen with a single
+     *        draw; in compat mode, reproduces the original sequence 
+     *        of draws (one draw per attempted direction)
+     *        draws from the current random stream (see Rng::current())
+     * time: O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    int chooseMove(const Enemy &e) const;
+
+    /*******************************************************************************
+     * isDormant(e) determines if e is to sleep: e is neither in the PC's chamber
+     *  nor within options->wakeRadius tiles of the PC
+     * time: O(1)
+     * *****************************************************************************/
+    bool isDormant(const Enemy &e) const;
+
+    /*******************************************************************************
+     * wakeNearPC() wakes the sleeping enemies that are no longer dormant (see 
+     *  isDormant()), which catch up on the moves they missed
+     * notes: enemies that never move are left to sleep
+     * time: O(#enemies woken * CATCH_UP_MIXING_MOVES + wakeRadius^2), plus
+     *       O(#enemies in the PC's chamber) when the PC enters a chamber
+     * *****************************************************************************/
+    void wakeNearPC();
+
+    /*******************************************************************************
+     * wake(e) wakes e if it sleeps and ever moves, and has it catch up on the 
+     *  moves it missed (see catchUp())
+     * time: O(CATCH_UP_MIXING_MOVES)
+     * *****************************************************************************/
+    void wake(Enemy &e);
+
+    /*******************************************************************************
+     * catchUp(e, missed) moves e as though it had made missed moves
+     * notes: hostile enemies chasing the PC (hard mode) make up to 
+     *        CATCH_UP_MIXING_MOVES of them; other enemies make them randomly,
+     *        unless there are at least CATCH_UP_MIXING_MOVES, after which
+     *        the enemy could be anywhere: it is put on a random empty floor 
+     *        tile of its chamber instead
+     *        the result is distributed about like the exact moves, not equal
+     *        to them (see GameOptions::exact)
+     * time: nondeterministic, O(CATCH_UP_MIXING_MOVES) expected
+     * *****************************************************************************/
+    void catchUp(Enemy &e, const int missed);
+
+    /*******************************************************************************
+     * act(e) has e take its action (see turnEnemies())
+     * time: O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    void act(Enemy &e);
+
+    /*******************************************************************************
+     * actInOrder(turns) has every enemy in turns act, in order, each drawing 
+     *  from the stream of its chamber
+     * time: O(|turns| * NUM_DIRECTIONS)
+     * *****************************************************************************/
+    void actInOrder(const std::vector<Enemy *> &turns);
+
+    /*******************************************************************************
+     * playChambers() has the enemies in pcTurns and chamberTurns act, the 
+     *  chambers in busyChambers on separate threads (see GameOptions::threads), 
+     *  and empties them
+     * notes: the chambers do not share cells, and only the enemies in pcTurns 
+     *        may touch the PC, so the result is the same as if each list had 
+     *        been played after the other
+     *        the occupancy layers are updated once every chamber is done
+     * exceptions: rethrows what an enemy throws (e.g. PCSlain), once every 
+     *             chamber is done
+     * time: O(#enemies acting * NUM_DIRECTIONS / #threads + #chambers) if the 
+     *       chambers are balanced
+     * *****************************************************************************/
+    void playChambers();
+
+    /*******************************************************************************
+     * applyChanges() updates the occupancy layers for the cells changed while 
+     *  the chambers were played, and empties the lists of enemies played
+     * time: O(#cells changed + #chambers)
+     * *****************************************************************************/
+    void applyChanges();
+
+    /*******************************************************************************
+     * clearOccupants() frees the enemies on the floor
+     * time: O(#enemies)
+     * *****************************************************************************/
+    void clearOccupants();
+
+    /*******************************************************************************
+     * freeCells() frees the cells and their chunks
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    void freeCells();
+
+    /*******************************************************************************
+     * build(filename) builds the floor from the configuration in filename, once
+     *  floorNum, pc and options are set
+     * notes: see reset()
+     * time: nondeterministic, O(numRows * numCols) expected
+     * *****************************************************************************/
+    void build(const std::string &filename);
+
   public:
     /*******************************************************************************
      * floor constructor create a floor from configuration in filename
-     * notes: if filename is EMPTY_CONFIG, populates it randomly
-     * required: filename is a valid configuration file (not checked)
+     * notes: if filename is EMPTY_CONFIG (or cannot be read), populates a 
+     *        newly generated layout randomly (in compat mode, the layout of 
+     *        EMPTY_CONFIG itself)
+     *        options must outlive the floor
+     *        the board is floorNum's board in filename (see Layout::load()),
+     *        with the dimensions of the configuration
+     * exceptions: throws GameError() if the configuration is invalid (e.g. it 
+     *             has an unknown character, a dragon away from any hoard, or
+     *             not exactly one PC), or if the layout of EMPTY_CONFIG is
+     *             needed but cannot be read
      * time: nondeterministic, 
-     *       O(NUM_ROWS * NUM_COLS) expected
+     *       O(numRows * numCols) expected
+     * *****************************************************************************/
+    Floor(const int floorNum, const std::string filename, PC &pc, const GameOptions &options);
+
+    /*******************************************************************************
+     * enter() lets the PC into the floor, at the location it was placed in 
+     *  when the floor was built, and prints any notices about building it
+     * notes: until then, building the floor does not change the PC, so the
+     *        floor can be built (on any thread) while the PC is elsewhere
+     *        makes the floor's arena current on the calling thread, so that
+     *        items created while the floor is played are released with it
+     * required: enter() has not been called yet
+     * time: O(numRows * numCols / 64)
+     * *****************************************************************************/
+    void enter();
+
+    // determines if the PC has entered the floor
+    bool isEntered() const;
+
+    /*******************************************************************************
+     * reset(floorNum, filename, pc, options) makes this the floor the constructor
+     *  would create for floorNum, filename, pc, options
+     * notes: frees the enemies left on the floor, and releases its arena (and
+     *        with it every item left) at once
+     *        reuses the cells and the rest of the storage of the floor, so
+     *        resetting to a board of the same size allocates nothing but the
+     *        new enemies (which are pooled; see Pool)
+     *        draws from the current random stream exactly as the constructor
+     * required: the PC is not on the floor, or is leaving it for good
+     * time: nondeterministic, O(numRows * numCols) expected
      * *****************************************************************************/
-    Floor(const int floorNum, const std::string filename, PC &pc);
+    void reset(const int floorNum, const std::string &filename, PC &pc, const GameOptions &options);
 
     /*******************************************************************************
      * floor destructor frees memory for cells, potions, gold, enemies
-     * time: O(NUM_ROWS * NUM_COLS) 
+     * time: O(numRows * numCols) 
      * *****************************************************************************/   
     ~Floor();
 
+    // getters for the dimensions of the board
+    int getNumRows() const;
+    int getNumCols() const;
+
+    /*******************************************************************************
+     * getCell(row, col) gets the cell at (row, col)
+     * notes: returns NULL if (row, col) is out of bounds or in a chunk of
+     *        only empty space
+     * time: O(1)
+     * *****************************************************************************/
+    Cell* getCell(const int row, const int col) const;
+
     /*******************************************************************************
      * addEnemy(e) adds e to list of enemies
      * time: O(1) 
@@ -85,18 +336,46 @@ class Floor {
     void removeEnemy(const Enemy &e);
 
     /*******************************************************************************
-     * turnEnemies() performs one turn for every enemy on the floor
+     * turnEnemies() has every enemy that is due act, until the PC's next turn 
+     *  (see Scheduler)
      * notes: each enemy tries to attack PC if it is in its 1 block radius
      *        if it cannot attack PC, it moves in a random direction
+     *        in hard mode, hostile enemies instead move closer to the PC 
+     *        whenever they can
      *        enemies never leave their chamber or pick up items
-     * time: nondeterministic, O(#enemies) expected
+     *        except in compat mode, enemies that never move sleep while the 
+     *        PC is not next to them; except in exact (or compat) mode, enemies
+     *        away from the PC also sleep on crowded floors (see enemiesSleep,
+     *        isDormant(), wakeNearPC())
+     *        except in compat mode, the enemies of each chamber act in order,
+     *        drawing from the chamber's stream, and the chambers not next to
+     *        the PC act at the same time (see playChambers())
+     * time: nondeterministic, O(#enemies acting + TICKS_PER_TURN) expected
      * *****************************************************************************/
     void turnEnemies();
 
+    /*******************************************************************************
+     * cellChanged(c) updates the occupancy layers for cell c
+     * notes: to be called by c whenever its type or occupants change
+     *        while the chambers are being played, only records c (see 
+     *        applyChanges())
+     * time: O(1)
+     * *****************************************************************************/
+    void cellChanged(const Cell &c);
+
+    // getter for the occupancy layer of the PC
+    const Bitboard& getPCCell() const;
+
     /*******************************************************************************
      * prints current floor configuration, PC stats and buffer of actions
+     * notes: boards larger than VIEWPORT_ROWS x VIEWPORT_COLS are printed 
+     *        through a window of that size centred on the PC (as far as 
+     *        the edges of the board allow)
+     *        the board is composed by copying the layout's background and 
+     *        writing the cells that have occupants (and the stairs) over it, 
+     *        then printed at once
      * effects: clears actions buffer
-     * time: O(NUM_ROWS * NUM_COLS + |actions|) 
+     * time: O(VIEWPORT_ROWS * VIEWPORT_COLS + |actions|) 
      * *****************************************************************************/
     friend std::ostream& operator<< (std::ostream& out, const Floor &f);
 };
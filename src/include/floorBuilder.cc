@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * floorBuilder.cc
+ * 
+ * Module implementing the building of the floors of a game ahead of time.
+ * ****************************************************************************/
+
+#include <cassert>
+#include <vector>
+#include "floorBuilder.h"
+#include "floor.h"
+#include "game.h"
+#include "rng.h"
+#include "trace.h"
+#include "arena.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+namespace {
+    // draws a seed from the current stream
+    unsigned int drawSeed() {
+        const unsigned int high = Rng::current().next();
+        return (high << 16) ^ Rng::current().next();
+    } // drawSeed()
+
+    // floors recycled so far, to be reset for later floors
+    class SpareFloors {
+      public:
+        vector<Floor *> floors;
+
+        // floors are recycled and reused on several threads
+        mutex lock;
+
+        // frees the floors at exit
+        ~SpareFloors() {
+            for (vector<Floor *>::iterator it = floors.begin(); it != floors.end(); ++it) {
+                delete *it;
+            } // for
+        } // ~SpareFloors()
+    };
+
+    SpareFloors spares;
+} // namespace
+
+// constructor
+FloorBuilder::FloorBuilder(const string filename, PC &pc, const GameOptions &options) :
+        filename(filename), pc(pc), options(options), 
+        seed(options.compat ? 0 : drawSeed()), session(Trace::session()), requestedNum(0), builtNum(0), 
+        built(NULL), stopping(false) {
+    if (options.compat) return;
+    lock_guard<mutex> guard(lock);
+    startBuilding(1);
+    worker = thread(&FloorBuilder::work, this);
+} // FloorBuilder ctor
+
+// destructor
+FloorBuilder::~FloorBuilder() {
+    if (!worker.joinable()) return;
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+    if (built) recycle(built);
+} // FloorBuilder dtor
+
+// see floorBuilder.h for details
+Floor* FloorBuilder::obtain(const int floorNum, const string filename, PC &pc, 
+                            const GameOptions &options) {
+    TraceSpan span("build floor", floorNum, Trace::session());
+    Floor *fl = NULL;
+    {
+        lock_guard<mutex> guard(spares.lock);
+        if (!spares.floors.empty()) {
+            fl = spares.floors.back();
+            spares.floors.pop_back();
+        } // if
+    }
+    if (!fl) return new Floor(floorNum, filename, pc, options);
+
+    try {
+        fl->reset(floorNum, filename, pc, options);
+    } catch (...) {
+        delete fl;
+        throw;
+    } // catch
+    return fl;
+} // obtain()
+
+// see floorBuilder.h for details
+Floor* FloorBuilder::build(const int floorNum, const string filename, PC &pc, 
+                           const GameOptions &options, const unsigned int seed) {
+    Rng stream(seed);
+    Rng::use(&stream);
+    try {
+        Floor *fl = obtain(floorNum, filename, pc, options);
+        Rng::use(NULL);
+        return fl;
+    } catch (...) {
+        Rng::use(NULL);
+        throw;
+    } // catch
+} // build()
+
+// see floorBuilder.h for details
+void FloorBuilder::work() {
+    Trace::useSession(session);
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        while (!stopping && !requestedNum) changed.wait(guard);
+        if (stopping) return;
+        const int floorNum = requestedNum;
+        requestedNum = 0;
+
+        // builds without holding the lock
+        guard.unlock();
+        Floor *fl = NULL;
+        exception_ptr error;
+        try {
+            fl = build(floorNum, filename, pc, options, Rng::substream(seed, floorNum));
+        } catch (...) {
+            error = current_exception();
+        } // catch
+        guard.lock();
+
+        builtNum = floorNum;
+        built = fl;
+        failure = error;
+        changed.notify_all();
+    } // while
+} // work()
+
+// see floorBuilder.h for details
+void FloorBuilder::startBuilding(const int floorNum) {
+    requestedNum = floorNum;
+    changed.notify_all();
+} // startBuilding()
+
+// see floorBuilder.h for details
+Floor* FloorBuilder::take(const int floorNum) {
+    assert(1 <= floorNum && floorNum <= NUM_FLOORS);
+    if (options.compat) return obtain(floorNum, filename, pc, options);
+
+    unique_lock<mutex> guard(lock);
+    while (builtNum != floorNum) changed.wait(guard);
+    Floor *fl = built;
+    exception_ptr error = failure;
+    builtNum = 0;
+    built = NULL;
+    failure = exception_ptr();
+    if (error) rethrow_exception(error);
+    if (floorNum < NUM_FLOORS) startBuilding(floorNum + 1);
+    return fl;
+} // take()
+
+// see floorBuilder.h for details
+void FloorBuilder::recycle(Floor *fl) {
+    // (the floor was entered on this thread, whose items would otherwise still
+    // come from the floor's arena while another thread resets it)
+    Arena::use(NULL);
+    lock_guard<mutex> guard(spares.lock);
+    spares.floors.push_back(fl);
+} // recycle()
@@ -0,0 +1,122 @@
+#ifndef __FLOOR_BUILDER_H__
+#define __FLOOR_BUILDER_H__
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+class Floor;
+class PC;
+struct GameOptions;
+
+class FloorBuilder {
+    // how the floors are to be built
+    const std::string filename;
+    PC &pc;
+    const GameOptions &options;
+
+    // seed of the random streams of the floors of this game
+    const unsigned int seed;
+
+    // session of the game (see Trace), for the worker
+    const int session;
+
+    // worker building the floors in the background (not started in compat mode)
+    std::thread worker;
+
+    // guards the state shared with the worker, which waits on changed
+    std::mutex lock;
+    std::condition_variable changed;
+
+    // floor the worker is asked to build next (0 if none)
+    int requestedNum;
+
+    // floor the worker has built (0 if none), or why it could not be built
+    int builtNum;
+    Floor *built;
+    std::exception_ptr failure;
+
+    // set when the worker is to exit
+    bool stopping;
+
+    /*******************************************************************************
+     * obtain(floorNum, filename, pc, options) gets floor floorNum, resetting a
+     *  recycled floor if there is one
+     * notes: traced as "build floor"
+     * time: see Floor::reset()
+     * *****************************************************************************/
+    static Floor* obtain(const int floorNum, const std::string filename, PC &pc, 
+                         const GameOptions &options);
+
+    /*******************************************************************************
+     * build(floorNum, filename, pc, options, seed) builds floor floorNum, drawing
+     *  from a stream seeded with seed
+     * notes: runs on the worker thread
+     * time: see Floor::reset()
+     * *****************************************************************************/
+    static Floor* build(const int floorNum, const std::string filename, PC &pc, 
+                        const GameOptions &options, const unsigned int seed);
+
+    // body of the worker thread: builds the requested floors until stopping
+    void work();
+
+    /*******************************************************************************
+     * startBuilding(floorNum) asks the worker to build floor floorNum
+     * required: lock is held
+     * time: O(1)
+     * *****************************************************************************/
+    void startBuilding(const int floorNum);
+
+    // builders cannot be copied
+    FloorBuilder(const FloorBuilder &other);
+    FloorBuilder& operator= (const FloorBuilder &other);
+
+  public:
+    /*******************************************************************************
+     * FloorBuilder constructor creates a builder for the floors of one game, 
+     *  with configuration from filename
+     * notes: except in compat mode, every floor is built on a worker thread
+     *        while the previous one is played, drawing from its own stream 
+     *        (derived from the current stream when the builder is created), 
+     *        so the floors do not depend on how the game is played or on 
+     *        when the worker runs
+     *        in compat mode, floors are built when they are needed, drawing
+     *        from the current stream, as originally
+     *        floors are reset in place from the ones recycled (see recycle()),
+     *        so that a game reaches a steady state with no floor allocated
+     *        pc and options must outlive the builder
+     * time: O(1)
+     * *****************************************************************************/
+    FloorBuilder(const std::string filename, PC &pc, const GameOptions &options);
+
+    /*******************************************************************************
+     * FloorBuilder destructor stops the worker and recycles the floor it built,
+     *  if any
+     * time: see Floor::reset()
+     * *****************************************************************************/
+    ~FloorBuilder();
+
+    /*******************************************************************************
+     * take(floorNum) gets floor floorNum, and starts building the next one
+     * notes: the floor has not been entered (see Floor::enter())
+     *        the caller owns the floor, and is to recycle it once it is played
+     * required: 1 <= floorNum <= NUM_FLOORS, floors are taken in order
+     * exceptions: throws GameError() if the configuration is invalid
+     * time: O(1) if the floor has been built already
+     * *****************************************************************************/
+    Floor* take(const int floorNum);
+
+    /*******************************************************************************
+     * recycle(fl) keeps fl (which the caller no longer uses) to build a later 
+     *  floor, of this game or of the next one
+     * notes: recycled floors are freed at exit
+     *        the calling thread stops allocating from the floor's arena (see
+     *        Floor::enter())
+     * time: O(1) amortized
+     * *****************************************************************************/
+    static void recycle(Floor *fl);
+};
+
+#endif
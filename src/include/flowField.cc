@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * flowField.cc
+ * 
+ * Module implementing a field of distances to a moving source (the PC).
+ * ****************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include <cassert>
+#include "flowField.h"
+#include "cell.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+const int FlowField::UNREACHABLE = INT_MAX;
+
+// constructor
+FlowField::FlowField(const int numRows, const int numCols) : 
+    numRows(numRows), numCols(numCols), source(0) {}
+
+// see flowField.h for details
+void FlowField::resize(const int numRows, const int numCols) {
+    this->numRows = numRows;
+    this->numCols = numCols;
+    // (clearing keeps the capacity, so the next computation reallocates nothing)
+    dist.clear();
+    cells.clear();
+    affected.clear();
+    source = NULL;
+} // resize()
+
+// see flowField.h for details
+int FlowField::indexOf(const Cell &c) const {
+    return c.getRow() * numCols + c.getCol();
+} // indexOf()
+
+// see flowField.h for details
+void FlowField::recompute(Cell &s) {
+    if (dist.empty()) {
+        dist.resize(numRows * numCols);
+        cells.resize(numRows * numCols, NULL);
+        affected.resize(numRows * numCols, false);
+    } // if
+    fill(dist.begin(), dist.end(), UNREACHABLE);
+
+    // breadth-first search from s
+    queue.clear();
+    dist[indexOf(s)] = 0;
+    cells[indexOf(s)] = &s;
+    queue.push_back(indexOf(s));
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const Cell &v = *cells[queue[head]];
+        const int d = dist[queue[head]] + 1;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            Cell *w = v.getNeighbor(dir);
+            if (!w || dist[indexOf(*w)] != UNREACHABLE) continue;
+            dist[indexOf(*w)] = d;
+            cells[indexOf(*w)] = w;
+            queue.push_back(indexOf(*w));
+        } // for
+    } // for
+} // recompute()
+
+// see flowField.h for details
+void FlowField::addSource(Cell &s) {
+    // pruned breadth-first search: only follows cells that get closer
+    queue.clear();
+    dist[indexOf(s)] = 0;
+    cells[indexOf(s)] = &s;
+    queue.push_back(indexOf(s));
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const Cell &v = *cells[queue[head]];
+        const int d = dist[queue[head]] + 1;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            Cell *w = v.getNeighbor(dir);
+            if (!w || dist[indexOf(*w)] <= d) continue;
+            dist[indexOf(*w)] = d;
+            cells[indexOf(*w)] = w;
+            queue.push_back(indexOf(*w));
+        } // for
+    } // for
+} // addSource()
+
+// see flowField.h for details
+void FlowField::removeSource(const Cell &s) {
+    // finds the cells whose every shortest path leads to s, level by level:
+    // a cell is affected if all of its neighbors one step closer are affected
+    touched.clear();
+    touched.push_back(indexOf(s));
+    affected[indexOf(s)] = true;
+    for (size_t head = 0; head < touched.size(); ++head) {
+        const Cell &v = *cells[touched[head]];
+        const int d = dist[touched[head]] + 1;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            const Cell *w = v.getNeighbor(dir);
+            if (!w || dist[indexOf(*w)] != d || affected[indexOf(*w)]) continue;
+
+            // looks for another parent of w that is unaffected
+            bool hasParent = false;
+            for (int i = 0; i < NUM_DIRECTIONS && !hasParent; ++i) {
+                const Cell *u = w->getNeighbor(i);
+                hasParent = u && dist[indexOf(*u)] == d - 1 && !affected[indexOf(*u)];
+            } // for
+            if (hasParent) continue;
+
+            affected[indexOf(*w)] = true;
+            touched.push_back(indexOf(*w));
+        } // for
+    } // for
+
+    // bounds each affected cell using its unaffected neighbors
+    heap.clear();
+    for (vector<int>::const_iterator it = touched.begin(); it != touched.end(); ++it) {
+        const Cell &v = *cells[*it];
+        int best = UNREACHABLE;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            const Cell *u = v.getNeighbor(dir);
+            if (u && !affected[indexOf(*u)] && dist[indexOf(*u)] != UNREACHABLE) {
+                best = min(best, dist[indexOf(*u)] + 1);
+            } // if
+        } // for
+        dist[*it] = best;
+        if (best != UNREACHABLE) heap.push_back(make_pair(best, *it));
+    } // for
+
+    // settles the affected cells in order of distance
+    make_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+        const pair<int, int> top = heap.back();
+        heap.pop_back();
+        if (top.first != dist[top.second]) continue;
+
+        const Cell &v = *cells[top.second];
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            const Cell *w = v.getNeighbor(dir);
+            if (!w || !affected[indexOf(*w)] || dist[indexOf(*w)] <= top.first + 1) continue;
+            dist[indexOf(*w)] = top.first + 1;
+            heap.push_back(make_pair(top.first + 1, indexOf(*w)));
+            push_heap(heap.begin(), heap.end(), greater<pair<int, int> >());
+        } // for
+    } // while
+
+    for (vector<int>::const_iterator it = touched.begin(); it != touched.end(); ++it) {
+        affected[*it] = false;
+    } // for
+} // removeSource()
+
+// see flowField.h for details
+void FlowField::setSource(Cell &s) {
+    if (&s == source) return;
+
+    // checks if s is next to the old source
+    bool adjacent = false;
+    for (int dir = 0; source && dir < NUM_DIRECTIONS && !adjacent; ++dir) {
+        adjacent = (source->getNeighbor(dir) == &s);
+    } // for
+
+    if (adjacent) {
+        addSource(s);
+        removeSource(*source);
+    } else {
+        recompute(s);
+    } // else
+    source = &s;
+} // setSource()
+
+// see flowField.h for details
+int FlowField::distance(const Cell &c) const {
+    return dist.empty() ? UNREACHABLE : dist[indexOf(c)];
+} // distance()
+
+// see flowField.h for details
+int FlowField::downhill(const Cell &c, const unsigned int moveMask) const {
+    int best = -1;
+    int bestDist = distance(c);
+    for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+        if (!(moveMask & (1u << dir))) continue;
+        const int d = distance(*c.getNeighbor(dir));
+        if (d < bestDist) {
+            best = dir;
+            bestDist = d;
+        } // if
+    } // for
+    return best;
+} // downhill()
@@ -0,0 +1,100 @@
+#ifndef __FLOW_FIELD_H__
+#define __FLOW_FIELD_H__
+
+#include <vector>
+#include <utility>
+
+class Cell;
+
+class FlowField {
+    // dimensions of the grid of cells
+    int numRows, numCols;
+
+    // distance (in moves) from every cell to the source;
+    // UNREACHABLE for cells that are not walkable or not connected to the source
+    std::vector<int> dist;
+
+    // cells indexed like dist (NULL until the cell has been reached once)
+    std::vector<Cell *> cells;
+
+    // cell the distances are measured from (NULL before the first computation)
+    const Cell *source;
+
+    // scratch space for updates (kept between calls to avoid reallocations)
+    std::vector<int> queue;
+    std::vector<char> affected;
+    std::vector<int> touched;
+    std::vector<std::pair<int, int> > heap;
+
+    // index of c in dist
+    int indexOf(const Cell &c) const;
+
+    /*******************************************************************************
+     * recompute(s) recomputes every distance by a breadth-first search from s
+     * time: O(#walkable cells)
+     * *****************************************************************************/
+    void recompute(Cell &s);
+
+    /*******************************************************************************
+     * addSource(s) lowers the distances to account for a new source s
+     * notes: afterwards, dist holds the distance to the closest of the
+     *        old and new sources
+     * time: O(#cells whose distance decreases)
+     * *****************************************************************************/
+    void addSource(Cell &s);
+
+    /*******************************************************************************
+     * removeSource(s) raises the distances to account for s no longer being a 
+     *  source
+     * required: s was a source and another source remains
+     * time: O(#cells whose distance increases * log)
+     * *****************************************************************************/
+    void removeSource(const Cell &s);
+
+  public:
+    // distance of cells that cannot reach the source
+    static const int UNREACHABLE;
+
+    /*******************************************************************************
+     * FlowField constructor creates an empty field for a numRows x numCols grid
+     * time: O(1)
+     * *****************************************************************************/
+    FlowField(const int numRows, const int numCols);
+
+    /*******************************************************************************
+     * resize(numRows, numCols) empties the field and makes it the field of a
+     *  numRows x numCols grid
+     * notes: reuses the storage of the field
+     * time: O(1)
+     * *****************************************************************************/
+    void resize(const int numRows, const int numCols);
+
+    /*******************************************************************************
+     * setSource(s) measures distances from s
+     * notes: if s is a walkable neighbor of the previous source, only the 
+     *        distances that change are updated; otherwise all distances are
+     *        recomputed
+     * time: O(#changed cells) if s is next to the previous source,
+     *       O(#walkable cells) otherwise
+     * *****************************************************************************/
+    void setSource(Cell &s);
+
+    /*******************************************************************************
+     * distance(c) gets the distance in moves from c to the source
+     * notes: returns UNREACHABLE if c cannot reach the source
+     * time: O(1)
+     * *****************************************************************************/
+    int distance(const Cell &c) const;
+
+    /*******************************************************************************
+     * downhill(c, moveMask) chooses the direction that gets closest to the source
+     *  from c, among the directions in moveMask (see Cell::enemyMoveMask())
+     * notes: returns the index in DIRECTIONS of the direction, or -1 if no 
+     *        allowed direction gets closer to the source
+     *        ties are broken in the order of DIRECTIONS
+     * time: O(NUM_DIRECTIONS)
+     * *****************************************************************************/
+    int downhill(const Cell &c, const unsigned int moveMask) const;
+};
+
+#endif
@@ -6,10 +6,16 @@
 
 #include <iomanip>
 #include <cassert>
+#include <cstdlib>
+#include <thread>
 #include "game.h"
 #include "floor.h"
+#include "floorBuilder.h"
 #include "enemy.h"
 #include "message.h"
+#include "console.h"
+#include "turnStats.h"
+#include "trace.h"
 #include "constants.h"
 
 using namespace std;
@@ -25,7 +31,8 @@ static PC& chooseCharacter(){
 
     char cmd;
     while (1) {
-        cin >> cmd;
+        // (the end of the input quits)
+        if (!Console::read(cmd)) cmd = 'q';
         if (cmd == 'q') throw PCQuit();
         if (cmd == 'r') throw PCRestart();
 
@@ -33,7 +40,7 @@ static PC& chooseCharacter(){
         try {
             return *createRace(cmd);
         } catch (PC::NotPCRace &e) {
-            cout << "Invalid race. Please try again." << endl;
+            Console::out() << "Invalid race. Please try again." << endl;
             printRaces();
         } // catch
     } // while
@@ -49,10 +56,11 @@ static void helpMenu(Floor &fl) {
     while (1) {
         printHelp();
         char cmd;
-        cin >> cmd;
+        // (the end of the input returns to the game)
+        if (!Console::read(cmd)) cmd = 'b';
         switch (cmd) {
             case 'b' : {
-                cout << fl << "Back to the game." << endl;
+                Console::out() << fl << "Back to the game." << endl;
                 return;
             } case 'c' : {
                 printCommands();
@@ -61,7 +69,7 @@ static void helpMenu(Floor &fl) {
                 printEnemies();
                 break;
             } case 'f' : {
-                cout << fl;
+                Console::out() << fl;
                 break;
             } case 'l' : {
                 printLegend();
@@ -70,107 +78,141 @@ static void helpMenu(Floor &fl) {
                 printRules();
                 break;                  
             } default : {
-                cout << "Invalid help option. Please try again." << endl;
+                Console::out() << "Invalid help option. Please try again." << endl;
             } // default
         } // switch
     } // while
 } // helpMenu()
 
 /*******************************************************************************
- * playFloor(floorNum,pc,filename) plays level floorNum, with configuration 
- *  from filename
+ * readCommand(dir) reads the next command, and stores in dir the direction 
+ *  that follows it for moves, attacks and trades
+ * notes: the end of the input reads as 'q'
+ *        timed as the input phase (including the wait for the input)
+ * time: O(1)
+ * *****************************************************************************/
+static char readCommand(string &dir) {
+    TIME_PHASE(Input);
+    char cmd;
+    // (the end of the input quits)
+    if (!Console::read(cmd)) return 'q';
+    if (cmd == 'n' || cmd == 's' || cmd == 'w' || cmd == 'e' || cmd == 'a' || cmd == 't') {
+        // direction characters
+        const char dir1 = (cmd == 'a' || cmd == 't') ? Console::get() : cmd;
+        const char dir2 = Console::get();
+        dir = "";
+        dir = dir + dir1 + dir2;
+    } // if
+    return cmd;
+} // readCommand()
+
+/*******************************************************************************
+ * playFloor(floorNum,pc,fl) plays level floorNum on floor fl
  * required: 1 <= floorNum <= NUM_FLOORS
- *           filename is a valid, readable file [not checked]
+ *           fl has not been entered yet
  * exceptions: may throw PCQuits(), PCRestarts(), PCSlain(), PCWon() as needed
  * effects: updates pc's stats as the level is played
  * time: O(|input| + floor area)
  * *****************************************************************************/
-static void playFloor(const int floorNum, PC &pc, const string filename) {
+static void playFloor(const int floorNum, PC &pc, Floor &fl) {
     assert(1 <= floorNum && floorNum <= constants::NUM_FLOORS);
 
-    // creates a new floor and prints it
-    Floor fl(floorNum, filename, pc);
+    // enters the new floor and prints it
+    fl.enter();
 
     if (floorNum == 1) pc.addAction("Player Character has spawned");
     else pc.addAction("Player Character enters a new floor");
 
-    cout << fl;
+    Console::out() << fl;
 
     try {
         // gets user commands until PC finishes floor,
         // loses, quits or restarts
         while(1) {
-            cout << endl << "Please enter a command." << endl;        
-            char cmd;
-            cin >> cmd;
+            Console::out() << endl << "Please enter a command." << endl;        
+            TurnStats::startTurn();
+            string dir;
+            const char cmd = readCommand(dir);
+            TraceSpan turn("turn", floorNum, Trace::session());
 
             if (cmd == 'q' || cmd == 'r') {
                 // quit, restart commands
-                delete &pc;
                 if (cmd == 'q') throw PCQuit();
                 else throw PCRestart();
             } else if (cmd == 'h') {
                 helpMenu(fl);
+            } else if (cmd == 'p' && TurnStats::current()) {
+                // phase times so far (with --stats, in builds that record them)
+                if (TurnStats::ENABLED) TurnStats::current()->print(Console::out());
+                else Console::out() << "Turn phase times are not recorded by this build (see TURN_STATS)." << endl;
             } else if (cmd == 'n' || cmd == 's' || cmd == 'w' || cmd == 'e' 
                         || cmd == 'a' || cmd == 't') {
-                // direction characters
-                const char dir1 = (cmd == 'a' || cmd == 't') ? cin.get() : cmd;
-                const char dir2 = cin.get();
-                // direction string
-                string dir = "";
-                dir = dir + dir1 + dir2;
-
                 if (cmd == 'a') {
                     // tries to perform PC's attack; if dodged, does nothing
                     try {
+                        TIME_PHASE(PCAction);
                         pc.attackInDirection(dir);
                     } catch (InvalidMove &e) {
-                        cout << "Invalid attack. " << e.what() << endl;
+                        Console::out() << "Invalid attack. " << e.what() << endl;
+                        TurnStats::endTurn();
                         continue;
                     } catch (Enemy::AttackDodged &e) {}
                 } else if (cmd == 't') {
                     // tries to perform trade; if no deal is reached
                     try {
+                        TIME_PHASE(PCAction);
                         pc.trade(dir);
                     } catch (InvalidMove &e) {
-                        cout << "Invalid trade. " << e.what() << endl;
+                        Console::out() << "Invalid trade. " << e.what() << endl;
+                        TurnStats::endTurn();
                         continue;
                     } catch (Merchant::NoDeal &e) {
-                        cout << fl << "Back to the game." << endl;
+                        Console::out() << fl << "Back to the game." << endl;
+                        TurnStats::endTurn();
                         continue;
                     } // catch
                 } else {
                     // tries to perform PC move
                     try {
+                        TIME_PHASE(PCAction);
                         pc.makeMove(dir);
                     } catch(ReachedStairs &e) {
                         // reached the stairs
                         pc.addAction("Player Character has reached the stairs at floor " + to_string(floorNum));
                         break;
                     } catch(InvalidMove &e) {
-                        cout << "Invalid move. " << e.what() << endl;
+                        Console::out() << "Invalid move. " << e.what() << endl;
+                        TurnStats::endTurn();
                         continue; 
                     } // catch
                 } // else
 
                 // enemies' turns
-                fl.turnEnemies();
+                {
+                    TIME_PHASE(Enemies);
+                    fl.turnEnemies();
+                }
 
                 // does any race-specific end-of-turn updates
-                pc.turnFinished();
+                {
+                    TIME_PHASE(TurnFinished);
+                    pc.turnFinished();
+                }
 
                 // prints new state
-                cout << fl;
+                TIME_PHASE(Render);
+                TraceSpan render("render", floorNum, Trace::session());
+                Console::out() << fl;
+                TurnStats::endTurn();
             } else {
-                cout << "Invalid command." << endl;
+                Console::out() << "Invalid command." << endl;
                 printCommands();
             } // else
         } // while
     } catch (PCSlain &e) {
         // prints PC's final state
-        cout << "The Player Character has been slain. Final Player Character Statistics: " << endl;
-        cout << pc;
-        delete &pc;
+        Console::out() << "The Player Character has been slain. Final Player Character Statistics: " << endl;
+        Console::out() << pc;
         throw e;
     } // catch
 
@@ -178,25 +220,125 @@ static void playFloor(const int floorNum, PC &pc, const string filename) {
     pc.clearDecorators();
 } // playFloor()
 
+/*******************************************************************************
+ * parsePositive(value, n) stores in n the positive number written in value
+ * notes: returns false (leaving n alone) if value is not a positive number of
+ *        at most 6 digits
+ * time: O(1)
+ * *****************************************************************************/
+static bool parsePositive(const string value, int &n) {
+    if (value.empty() || value.size() > 6 
+        || value.find_first_not_of("0123456789") != string::npos) return false;
+    const int parsed = atoi(value.c_str());
+    if (parsed <= 0) return false;
+    n = parsed;
+    return true;
+} // parsePositive()
+
+// default options
+GameOptions::GameOptions() : compat(false), hard(false), exact(false), 
+                             wakeRadius(constants::DEFAULT_WAKE_RADIUS), 
+                             threads(max((int) thread::hardware_concurrency(), 1)),
+                             stats(false), raw(false) {}
+
 // see game.h for details
-void playGame(const string filename) {
-    // merchants are not hostile initially
-    Merchant::resetHostile();
+bool parseOption(const string arg, GameOptions &options) {
+    if (arg == "--compat") {
+        options.compat = true;
+        return true;
+    } else if (arg == "--hard") {
+        options.hard = true;
+        return true;
+    } else if (arg == "--exact") {
+        options.exact = true;
+        return true;
+    } else if (arg.compare(0, 9, "--radius=") == 0) {
+        return parsePositive(arg.substr(9), options.wakeRadius);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+        return parsePositive(arg.substr(10), options.threads);
+    } else if (arg == "--stats") {
+        options.stats = true;
+        return true;
+    } else if (arg.compare(0, 8, "--trace=") == 0 && arg.size() > 8) {
+        options.traceFile = arg.substr(8);
+        return true;
+    } else if (arg == "--raw") {
+        options.raw = true;
+        return true;
+    } // else if
+    return false;
+} // parseOption()
 
+// see game.h for details
+void playGame(const string filename, const GameOptions &options) {
     // choose character from user input
     PC &pc = chooseCharacter();
 
     // plays each level until player quits, restarts, loses or wins
-    for (int floorNum = 1; floorNum <= constants::NUM_FLOORS; ++floorNum) {
-        playFloor(floorNum, pc, filename);
-    } // for
+    // (each floor is built while the previous one is played, from the floors
+    // played before; the builder is stopped before the PC is freed, however
+    // the game ends)
+    try {
+        FloorBuilder builder(filename, pc, options);
+        for (int floorNum = 1; floorNum <= constants::NUM_FLOORS; ++floorNum) {
+            Floor *fl = builder.take(floorNum);
+            try {
+                playFloor(floorNum, pc, *fl);
+            } catch (...) {
+                builder.recycle(fl);
+                throw;
+            } // catch
+            builder.recycle(fl);
+        } // for
+    } catch (...) {
+        delete &pc;
+        throw;
+    } // catch
 
     // player won
-    cout << "Your score is " << (int) (pc.getGold() * pc.scoreMultiplier()) << "." << endl;
+    Console::out() << "Your score is " << (int) (pc.getGold() * pc.scoreMultiplier()) << "." << endl;
     delete &pc;
     throw PCWon();
 } // playGame()
 
+// see game.h for details
+void playGames(const string filename, const GameOptions &options) {
+    // times the turns of this session if asked to
+    TurnStats stats;
+    if (options.stats) TurnStats::use(&stats);
+    Trace::newSession();
+
+    try {  
+        while(1) {
+            try {
+                playGame(filename, options);
+            } catch (PCRestart &e) {
+                Console::out() << "The game restarts." << endl;
+            } // catch
+        } // while
+    } catch (PCSlain &e) {
+        Console::out() << "Game over." << endl;
+    } catch (PCQuit &e) {
+        Console::out() << "You quit." << endl;
+    } catch (PCWon &e) {
+        Console::out() << "Congratulations! You WIN!!!!" << endl;        
+    } catch (...) {
+        TurnStats::use(NULL);
+        throw;
+    } // catch
+
+    // prints the phase times at the end of the session
+    TurnStats::use(NULL);
+    if (!options.stats) return;
+    if (TurnStats::ENABLED) stats.print(cerr);
+    else cerr << "Turn phase times are not recorded by this build (see TURN_STATS)." << endl;
+} // playGames()
+
+// constructor
+GameException::GameException() {
+    COUNT_THROW();
+} // GameException ctor
+
 /**************************** Exception Messages ***********************************/
 const char * UnwalkableCell::what () const noexcept{
         return "ERROR: Tile is not walkable.";
@@ -4,16 +4,76 @@
 #include <exception>
 #include <string>
 
+/*******************************************************************************
+ * GameOptions holds the command-line switches that change how a game is played
+ * *****************************************************************************/
+struct GameOptions {
+    // reproduces the random draw sequence of the original implementation
+    // (needed to replay the recorded test outputs)
+    bool compat;
+
+    // enemies chase the PC instead of wandering randomly
+    bool hard;
+
+    // simulates every enemy every turn, instead of letting the enemies away 
+    // from the PC sleep (always the case in compat mode)
+    bool exact;
+
+    // enemies within this many tiles of the PC (or in its chamber) are awake
+    int wakeRadius;
+
+    // threads moving the enemies of separate chambers at once (the game plays
+    // out the same for any number)
+    int threads;
+
+    // times the phases of every turn, printing their histograms at the end of
+    // the session (see TurnStats)
+    bool stats;
+
+    // file a Chrome trace of the game is recorded into (none if empty; see 
+    // Trace)
+    std::string traceFile;
+
+    // reads every key as it is pressed and redraws only what changed, when 
+    // playing on a terminal (see Console::useRawTerminal())
+    bool raw;
+
+    // default options
+    GameOptions();
+};
+
+/*******************************************************************************
+ * parseOption(arg, options) updates options according to the switch in arg
+ * notes: returns false if arg is not a valid switch
+ * time: O(|arg|)
+ * *****************************************************************************/
+bool parseOption(const std::string arg, GameOptions &options);
+
 /*******************************************************************************
  * playGame() plays the game
  * filename indicates where default floor configuration is to be loaded from
+ * options indicates how the game is to be played
  * exceptions: throws PCQuit, PCRestart, PCWon, GameError as appropriate
  * *****************************************************************************/
-void playGame(const std::string filename);
+void playGame(const std::string filename, const GameOptions &options);
+
+/*******************************************************************************
+ * playGames(filename, options) plays games until the player wins, loses or 
+ *  quits, starting over whenever the player restarts
+ * notes: see playGame()
+ *        reads commands through Console::read() and Console::get() and prints
+ *        to Console::out(); the end of the input quits
+ * exceptions: throws GameError if a configuration is invalid
+ * *****************************************************************************/
+void playGames(const std::string filename, const GameOptions &options);
 
 /****************************** GAME EXCEPTIONS ********************************/
 // base game exception
-class GameException : public std::exception {};
+// (counted by the turn statistics whenever one is created; see TurnStats)
+class GameException : public std::exception {
+  public:
+    GameException();
+};
 
 // event exceptions
 class InvalidFile : public GameException {};
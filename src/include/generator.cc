@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * generator.cc
+ * 
+ * Module implementing the procedural generation of floor configurations.
+ * ****************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include "generator.h"
+
+using namespace std;
+using namespace constants;
+
+const int Generator::MIN_ROOM_ROWS, Generator::MAX_ROOM_ROWS;
+const int Generator::MIN_ROOM_COLS, Generator::MAX_ROOM_COLS;
+const int Generator::ROOM_GAP;
+
+// constructor
+Generator::Generator(const unsigned int s) : numRows(0), numCols(0), numSearches(0) {
+    seed(s);
+} // Generator ctor
+
+// see generator.h for details
+void Generator::seed(const unsigned int s) {
+    // xorshift never leaves 0
+    state = s ? s : 0x9E3779B9u;
+} // seed()
+
+// see generator.h for details
+unsigned int Generator::next() {
+    // xorshift
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+} // next()
+
+// see generator.h for details
+int Generator::between(const int lo, const int hi) {
+    return lo + next() % (hi - lo + 1);
+} // between()
+
+// see generator.h for details
+char& Generator::at(const int row, const int col) {
+    return tiles[row * numCols + col];
+} // at()
+
+// see generator.h for details
+bool Generator::placeRoom() {
+    // a room needs its walls and an empty tile between them and the border
+    const int maxRows = min(MAX_ROOM_ROWS, numRows - 6);
+    const int maxCols = min(MAX_ROOM_COLS, numCols - 6);
+    if (maxRows < MIN_ROOM_ROWS || maxCols < MIN_ROOM_COLS) return false;
+
+    const int roomRows = between(MIN_ROOM_ROWS, maxRows);
+    const int roomCols = between(MIN_ROOM_COLS, maxCols);
+    Room r;
+    r.top = between(2, numRows - 4 - roomRows);
+    r.left = between(2, numCols - 4 - roomCols);
+    r.bottom = r.top + roomRows + 1;
+    r.right = r.left + roomCols + 1;
+
+    // the room and the gap around it must be empty
+    for (int row = max(1, r.top - ROOM_GAP); row <= min(numRows - 2, r.bottom + ROOM_GAP); ++row) {
+        for (int col = max(1, r.left - ROOM_GAP); col <= min(numCols - 2, r.right + ROOM_GAP); ++col) {
+            if (at(row, col) != ' ') return false;
+        } // for
+    } // for
+
+    // builds the walls and the floor
+    for (int row = r.top; row <= r.bottom; ++row) {
+        for (int col = r.left; col <= r.right; ++col) {
+            if (col == r.left || col == r.right) at(row, col) = '|';
+            else if (row == r.top || row == r.bottom) at(row, col) = '-';
+            else at(row, col) = '.';
+        } // for
+    } // for
+    rooms.push_back(r);
+    return true;
+} // placeRoom()
+
+// see generator.h for details
+void Generator::doorway(const Room &r, const int targetRow, const int targetCol, int &row, int &col) {
+    // picks the wall facing the target
+    const int rowDistance = targetRow < r.top ? r.top - targetRow 
+                          : targetRow > r.bottom ? targetRow - r.bottom : 0;
+    const int colDistance = targetCol < r.left ? r.left - targetCol 
+                          : targetCol > r.right ? targetCol - r.right : 0;
+    if (rowDistance >= colDistance) {
+        // top or bottom wall
+        col = between(r.left + 1, r.right - 1);
+        const int wall = targetRow < r.top ? r.top : r.bottom;
+        at(wall, col) = '+';
+        row = wall == r.top ? wall - 1 : wall + 1;
+    } else {
+        // left or right wall
+        row = between(r.top + 1, r.bottom - 1);
+        const int wall = targetCol < r.left ? r.left : r.right;
+        at(row, wall) = '+';
+        col = wall == r.left ? wall - 1 : wall + 1;
+    } // if
+} // doorway()
+
+// see generator.h for details
+bool Generator::digBend(const int fromRow, const int fromCol, const int toRow, const int toCol, 
+                        const bool horizontalFirst) {
+    // the passage is a horizontal stretch along hRow and a vertical one along vCol
+    const int hRow = horizontalFirst ? fromRow : toRow;
+    const int vCol = horizontalFirst ? toCol : fromCol;
+    const int loRow = min(fromRow, toRow), hiRow = max(fromRow, toRow);
+    const int loCol = min(fromCol, toCol), hiCol = max(fromCol, toCol);
+
+    for (int col = loCol; col <= hiCol; ++col) {
+        if (at(hRow, col) != ' ' && at(hRow, col) != '#') return false;
+    } // for
+    for (int row = loRow; row <= hiRow; ++row) {
+        if (at(row, vCol) != ' ' && at(row, vCol) != '#') return false;
+    } // for
+
+    for (int col = loCol; col <= hiCol; ++col) at(hRow, col) = '#';
+    for (int row = loRow; row <= hiRow; ++row) at(row, vCol) = '#';
+    return true;
+} // digBend()
+
+// see generator.h for details
+void Generator::connect(const Room &a, const Room &b) {
+    int fromRow, fromCol, toRow, toCol;
+    doorway(a, (b.top + b.bottom) / 2, (b.left + b.right) / 2, fromRow, fromCol);
+    doorway(b, (a.top + a.bottom) / 2, (a.left + a.right) / 2, toRow, toCol);
+
+    // tries a passage with a single bend first
+    const bool horizontalFirst = next() & 1;
+    if (digBend(fromRow, fromCol, toRow, toCol, horizontalFirst)) return;
+    if (digBend(fromRow, fromCol, toRow, toCol, !horizontalFirst)) return;
+
+    // otherwise, breadth-first search through empty space and passages
+    static const int OFFSETS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    ++numSearches;
+    const int from = fromRow * numCols + fromCol, to = toRow * numCols + toCol;
+    int tail = 0;
+    visited[from] = numSearches;
+    queue[tail++] = from;
+    for (int head = 0; head < tail && visited[to] != numSearches; ++head) {
+        const int tile = queue[head];
+        for (int i = 0; i < 4; ++i) {
+            const int row = tile / numCols + OFFSETS[i][0], col = tile % numCols + OFFSETS[i][1];
+            if (row < 1 || col < 1 || row > numRows - 2 || col > numCols - 2) continue;
+            const int neighbor = row * numCols + col;
+            if (visited[neighbor] == numSearches) continue;
+            if (at(row, col) != ' ' && at(row, col) != '#') continue;
+            visited[neighbor] = numSearches;
+            previous[neighbor] = tile;
+            queue[tail++] = neighbor;
+        } // for
+    } // for
+
+    // digs the passage found (the empty space between rooms is connected)
+    if (visited[to] != numSearches) return;
+    for (int tile = to; tile != from; tile = previous[tile]) tiles[tile] = '#';
+    tiles[from] = '#';
+} // connect()
+
+// see generator.h for details
+vector<string> Generator::generate(const int numRows, const int numCols) {
+    vector<string> rows;
+    generate(rows, numRows, numCols);
+    return rows;
+} // generate()
+
+// see generator.h for details
+void Generator::generate(vector<string> &rows, const int numRows, const int numCols) {
+    this->numRows = numRows;
+    this->numCols = numCols;
+    tiles.assign(numRows * numCols, ' ');
+    rooms.clear();
+    visited.assign(numRows * numCols, 0);
+    previous.resize(numRows * numCols);
+    queue.resize(numRows * numCols);
+    numSearches = 0;
+
+    // draws the border
+    for (int row = 0; row < numRows; ++row) {
+        for (int col = 0; col < numCols; ++col) {
+            if (col == 0 || col == numCols - 1) at(row, col) = '|';
+            else if (row == 0 || row == numRows - 1) at(row, col) = '-';
+        } // for
+    } // for
+
+    // places rooms; the number of rooms grows with the area of the board
+    const int maxRooms = max(2, numRows * numCols / 250);
+    for (int attempt = 0; attempt < 20 * maxRooms && (int) rooms.size() < maxRooms; ++attempt) {
+        placeRoom();
+    } // for
+
+    // joins every room to the closest of the rooms placed before it
+    for (size_t i = 1; i < rooms.size(); ++i) {
+        size_t closest = 0;
+        int closestDistance = -1;
+        for (size_t j = 0; j < i; ++j) {
+            const int distance = abs(rooms[i].top + rooms[i].bottom - rooms[j].top - rooms[j].bottom)
+                               + abs(rooms[i].left + rooms[i].right - rooms[j].left - rooms[j].right);
+            if (closestDistance == -1 || distance < closestDistance) {
+                closest = j;
+                closestDistance = distance;
+            } // if
+        } // for
+        connect(rooms[i], rooms[closest]);
+    } // for
+
+    rows.resize(numRows);
+    for (int row = 0; row < numRows; ++row) {
+        rows[row].assign(&tiles[row * numCols], numCols);
+    } // for
+} // generate(rows)
@@ -0,0 +1,121 @@
+#ifndef __GENERATOR_H__
+#define __GENERATOR_H__
+
+#include <string>
+#include <vector>
+#include "constants.h"
+
+class Generator {
+    // a room, given by the rows and columns of its walls
+    struct Room {
+        int top, left, bottom, right;
+    };
+
+    // state of the generator's own random number sequence
+    unsigned int state;
+
+    // dimensions of the board being generated
+    int numRows, numCols;
+
+    // board being generated, row by row
+    std::vector<char> tiles;
+
+    // rooms placed so far
+    std::vector<Room> rooms;
+
+    // visit marks and predecessors for corridor searches (marked with the
+    // number of the search, so that they never need to be cleared)
+    std::vector<int> visited;
+    std::vector<int> previous;
+    std::vector<int> queue;
+    int numSearches;
+
+    // gets the next random number of the generator's sequence
+    unsigned int next();
+
+    // gets a random number in [lo, hi]
+    int between(const int lo, const int hi);
+
+    // character at (row, col) of the board being generated
+    char& at(const int row, const int col);
+
+    /*******************************************************************************
+     * placeRoom() tries to place a room of random size at a random position
+     * notes: rooms are kept at least ROOM_GAP tiles apart (and 1 tile away from
+     *        the border), so that the empty space between them stays connected
+     * returns: true if the room was placed
+     * time: O(area of the room)
+     * *****************************************************************************/
+    bool placeRoom();
+
+    /*******************************************************************************
+     * doorway(r, target, row, col) makes a doorway in the wall of room r facing 
+     *  (target row, target col) and stores the tile just outside it in row, col
+     * time: O(1)
+     * *****************************************************************************/
+    void doorway(const Room &r, const int targetRow, const int targetCol, int &row, int &col);
+
+    /*******************************************************************************
+     * digBend(fromRow, fromCol, toRow, toCol, horizontalFirst) digs a passage
+     *  with a single bend between two tiles, if it only goes through empty 
+     *  space and other passages
+     * returns: true if the passage was dug
+     * time: O(numRows + numCols)
+     * *****************************************************************************/
+    bool digBend(const int fromRow, const int fromCol, const int toRow, const int toCol, 
+                 const bool horizontalFirst);
+
+    /*******************************************************************************
+     * connect(a, b) digs a passage between doorways of rooms a and b
+     * notes: passages only go through empty space and other passages
+     *        passages have at most one bend, unless something is in the way
+     * time: O(numRows * numCols) worst case, usually O(numRows + numCols)
+     * *****************************************************************************/
+    void connect(const Room &a, const Room &b);
+
+  public:
+    // smallest and largest rooms, measured inside their walls
+    static const int MIN_ROOM_ROWS = 3, MAX_ROOM_ROWS = 8;
+    static const int MIN_ROOM_COLS = 6, MAX_ROOM_COLS = 24;
+
+    // least number of empty tiles between the walls of two rooms
+    static const int ROOM_GAP = 2;
+
+    /*******************************************************************************
+     * Generator constructor creates a generator whose layouts are determined 
+     *  by seed
+     * time: O(1)
+     * *****************************************************************************/
+    explicit Generator(const unsigned int seed);
+
+    /*******************************************************************************
+     * seed(s) makes the generator's next layouts determined by s
+     * time: O(1)
+     * *****************************************************************************/
+    void seed(const unsigned int s);
+
+    /*******************************************************************************
+     * generate(numRows, numCols) generates the rows of a new configuration with
+     *  rooms (chambers) joined by doorways and passages
+     * notes: uses the tiles of configuration files ('|', '-', '+', '#', '.');
+     *        the configuration contains no characters, items or stairs
+     *        every room can be reached from every other room
+     *        the same seed and dimensions always generate the same configuration
+     * required: numRows, numCols are large enough for a room
+     * time: O(numRows * numCols) expected
+     * *****************************************************************************/
+    std::vector<std::string> generate(const int numRows = constants::NUM_ROWS, 
+                                      const int numCols = constants::NUM_COLS);
+
+    /*******************************************************************************
+     * generate(rows, numRows, numCols) generates a configuration like 
+     *  generate(numRows, numCols), but stores its rows in rows
+     * notes: reuses the storage of rows and of the generator, so generating 
+     *        boards of the same size again allocates nothing
+     * time: O(numRows * numCols) expected
+     * *****************************************************************************/
+    void generate(std::vector<std::string> &rows, const int numRows = constants::NUM_ROWS, 
+                  const int numCols = constants::NUM_COLS);
+};
+
+#endif
@@ -10,6 +10,8 @@
 #include "enemy.h"
 #include "potion.h"
 #include "constants.h"
+#include "rng.h"
+#include "arena.h"
 
 using namespace std;
 using namespace constants;
@@ -20,6 +22,14 @@ Item::Item(const char token) : token(token) {}
 // destructor
 Item::~Item() {}
 
+// see item.h for details
+void* Item::operator new(size_t size) {
+    return Arena::current().allocate(size);
+} // operator new
+
+// see item.h for details
+void Item::operator delete(void *p, size_t size) {}
+
 // constructors for gold hoard types
 Gold::Gold(const int value) : Item('G'), value(value) {}
 SmallHoard::SmallHoard() : Gold(constants::SMALL_HOARD_VALUE) {}
@@ -30,10 +40,6 @@ DragonHoard::DragonHoard() : Gold(constants::DRAGON_HOARD_VALUE), dragon(0) {}
 // gold destructors
 Gold::~Gold() {}
 
-DragonHoard::~DragonHoard() {
-    delete dragon;
-} // dtor
-
 // DHCreated() constructor
 Item::DHCreated::DHCreated(DragonHoard &dh) : dh(dh) {}
 
@@ -54,6 +60,11 @@ void DragonHoard::detachDragon(){
     dragon = NULL;
 } // detachDragon()
 
+// see item.h for details
+bool DragonHoard::isGuarded() const {
+    return dragon;
+} // isGuarded()
+
 // see item.h for details
 char Item::getToken() const {
     return token;
@@ -99,7 +110,7 @@ Item * createItem(const char type) {
     assert (type == 'P' || type == 'G');
     if (type == 'P') {
         // create random potion
-        const int random = rand() % POTION_DENOMINATOR;
+        const int random = Rng::current().next() % POTION_DENOMINATOR;
         switch (random) {
             case (0) : return new RH();
             case (1) : return new BA();
@@ -110,7 +121,7 @@ Item * createItem(const char type) {
         } // switch
     } else {
         // create random treasure
-        int random = rand() % GOLD_DENOMINATOR;
+        int random = Rng::current().next() % GOLD_DENOMINATOR;
         if (random <= PROB_NORMAL_GOLD) return new NormalHoard();
         random -= PROB_NORMAL_GOLD;
         if (random <= PROB_DRAGON_GOLD) {
@@ -1,6 +1,7 @@
 #ifndef __ITEM_H__
 #define __ITEM_H__
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include "game.h"
@@ -20,6 +21,17 @@ class Item {
 
   public :
     virtual ~Item();
+
+    /*******************************************************************************
+     * operator new takes items from the current arena (see Arena), which is the
+     *  arena of the floor being built or played
+     * notes: items are never deleted; they are released along with their floor's 
+     *        arena, and so may not own anything outside it
+     * *****************************************************************************/
+    static void* operator new(std::size_t size);
+
+    // operator delete does nothing (it is only called if a constructor throws)
+    static void operator delete(void *p, std::size_t size);
     
     // exception to be thrown when a Dragon Hoard is created
     // in order for floor to create a nearby dragon
@@ -90,7 +102,6 @@ class DragonHoard : public Gold {
 
   public:
     DragonHoard();
-    ~DragonHoard();
 
     /*******************************************************************************
      * attachDragon(d) adds dragon guardian d to this Dragon Hoard
@@ -109,6 +120,9 @@ class DragonHoard : public Gold {
      * *****************************************************************************/    
     void detachDragon();
 
+    // predicate testing if a dragon guards this hoard
+    bool isGuarded() const;
+
     // see Gold::pickUp()
     void pickUp(Player &p);
 };
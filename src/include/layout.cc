@@ -0,0 +1,622 @@
+/*******************************************************************************
+ * layout.cc
+ * 
+ * Module implementing the parsed (static) part of a floor configuration.
+ * ****************************************************************************/
+
+#include <map>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "layout.h"
+#include "distanceTable.h"
+#include "game.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+namespace {
+    // frees layouts (the first one unmaps the file the others may point into)
+    void freeLayouts(vector<Layout *> &layouts) {
+        for (vector<Layout *>::iterator it = layouts.begin(); it != layouts.end(); ++it) delete *it;
+        layouts.clear();
+    } // freeLayouts()
+
+    // layouts of the floors of every configuration loaded so far, by filename
+    class LayoutCache {
+      public:
+        map<string, vector<Layout *> > files;
+
+        // floors may be built on several threads at once
+        mutex lock;
+
+        // frees the layouts at exit
+        ~LayoutCache() {
+            for (map<string, vector<Layout *> >::iterator it = files.begin(); it != files.end(); ++it) {
+                freeLayouts(it->second);
+            } // for
+        } // ~LayoutCache()
+    };
+
+    LayoutCache cache;
+
+    // splits the text from begin to end into the rows of a configuration, 
+    // ignoring line endings and trailing blank lines
+    vector<string> readRows(const char *begin, const char *end) {
+        vector<string> rows;
+        while (begin != end) {
+            const char *newline = find(begin, end, '\n');
+            const char *rowEnd = (newline != begin && newline[-1] == '\r') ? newline - 1 : newline;
+            rows.push_back(string(begin, rowEnd));
+            begin = (newline == end) ? end : newline + 1;
+        } // while
+        while (!rows.empty() && rows.back().empty()) rows.pop_back();
+        return rows;
+    } // readRows()
+
+    // lines starting with FLOOR_SEPARATOR separate the boards of a 
+    // configuration holding a board per floor (e.g. "=== floor 2 ===")
+    const char FLOOR_SEPARATOR = '=';
+
+    // adds the layouts of the boards in rows (split at separator lines, 
+    // ignoring blank lines at the end of every board) to floors: one board, or
+    // one per floor; gets false (adding nothing) if there is any other number
+    // of boards, or an empty one
+    bool addBoards(const vector<string> &rows, vector<Layout *> &floors) {
+        vector<vector<string> > boards(1);
+        for (vector<string>::const_iterator it = rows.begin(); it != rows.end(); ++it) {
+            if (!it->empty() && (*it)[0] == FLOOR_SEPARATOR) boards.push_back(vector<string>());
+            else boards.back().push_back(*it);
+        } // for
+        if (boards.size() != 1 && boards.size() != (size_t) NUM_FLOORS) return false;
+        for (vector<vector<string> >::iterator it = boards.begin(); it != boards.end(); ++it) {
+            while (!it->empty() && it->back().empty()) it->pop_back();
+            if (it->empty()) return false;
+        } // for
+        for (vector<vector<string> >::const_iterator it = boards.begin(); it != boards.end(); ++it) {
+            floors.push_back(new Layout(*it));
+        } // for
+        return true;
+    } // addBoards()
+
+    // size of the longest row
+    int longestRow(const vector<string> &rows) {
+        size_t longest = 0;
+        for (vector<string>::const_iterator it = rows.begin(); it != rows.end(); ++it) {
+            longest = max(longest, it->size());
+        } // for
+        return longest;
+    } // longestRow()
+
+    // determines if configuration character ch is part of a chamber
+    bool isChamberTile(const char ch) {
+        switch (ch) {
+            case '.': case '@': case '\\':
+            case 'H': case 'W': case 'E': case 'O': case 'M': case 'D': case 'L':
+                return true;
+            default:
+                return '0' <= ch && ch <= '9';
+        } // switch
+    } // isChamberTile()
+
+    // determines if configuration character ch is walkable
+    bool isWalkableTile(const char ch) {
+        return ch == '+' || ch == '#' || isChamberTile(ch);
+    } // isWalkableTile()
+
+    // gets how configuration character ch is printed with nothing standing on it
+    char backgroundTile(const char ch) {
+        if (ch == '\\' || ch == '+' || ch == '#' || ch == '|' || ch == '-' || ch == ' ') return ch;
+        return '.';
+    } // backgroundTile()
+
+    // compiled configurations start with COMPILED_MAGIC, then their version
+    // (which changes whenever their format does)
+    const char COMPILED_MAGIC[8] = {'D', 'C', 'L', 'A', 'Y', 'O', 'U', 'T'};
+    const uint32_t COMPILED_VERSION = 1;
+
+    // determines if the file between begin and end is a compiled configuration
+    bool isCompiled(const char *begin, const char *end) {
+        return (size_t) (end - begin) >= sizeof(COMPILED_MAGIC) && memcmp(begin, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) == 0;
+    } // isCompiled()
+
+    // largest dimension of a compiled configuration
+    const int MAX_COMPILED_DIMENSION = 1 << 14;
+
+    // header of a compiled configuration
+    struct CompiledHeader {
+        char magic[8];
+        uint32_t version;
+        int32_t numRows, numCols, numChambers, numHoards;
+        uint32_t unused;
+        // FNV-1a hash of everything after the header
+        uint64_t checksum;
+    };
+
+    // offsets of the sections of a compiled configuration (after its header, 
+    // each aligned on 8 bytes), and its size
+    struct Sections {
+        size_t tiles, chambers, neighbors, hoards, size;
+    };
+
+    // size rounded up to a multiple of 8 bytes
+    size_t aligned(const size_t size) {
+        return (size + 7) / 8 * 8;
+    } // aligned()
+
+    // gets the sections of a compiled configuration
+    Sections sections(const int numRows, const int numCols, const int numHoards) {
+        const size_t area = (size_t) numRows * numCols;
+        Sections s;
+        s.tiles = sizeof(CompiledHeader);
+        s.chambers = s.tiles + aligned(area);
+        s.neighbors = s.chambers + aligned(area * sizeof(int32_t));
+        s.hoards = s.neighbors + aligned(area);
+        s.size = s.hoards + (size_t) numHoards * 2 * sizeof(int32_t);
+        return s;
+    } // sections()
+
+    // FNV-1a hash of the bytes from begin to end
+    uint64_t checksum(const char *begin, const char *end) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const char *p = begin; p != end; ++p) {
+            hash ^= (unsigned char) *p;
+            hash *= 1099511628211ULL;
+        } // for
+        return hash;
+    } // checksum()
+} // namespace
+
+// (compiled configurations store the chambers and hoards as they are in memory)
+static_assert(sizeof(int) == sizeof(int32_t), "compiled configurations need 32-bit ints");
+
+// constructor
+Layout::Layout() : numRows(0), numCols(0), tileData(NULL), chamberData(NULL), neighborData(NULL), 
+        hoardData(NULL), numHoards(0), mapping(NULL), mappingSize(0), numChambers(0), distances(0) {
+} // Layout ctor
+
+// constructor
+Layout::Layout(const vector<string> &rows) : numRows(0), numCols(0), tileData(NULL), chamberData(NULL), 
+        neighborData(NULL), hoardData(NULL), numHoards(0), mapping(NULL), mappingSize(0), numChambers(0), 
+        distances(0) {
+    assign(rows);
+} // Layout ctor
+
+// destructor
+Layout::~Layout() {
+    delete distances;
+    if (mapping) munmap(mapping, mappingSize);
+} // ~Layout()
+
+// see layout.h for details
+void Layout::assign(const vector<string> &rows) {
+    numRows = rows.size();
+    numCols = longestRow(rows);
+    tiles.assign(numRows * numCols, ' ');
+    for (int row = 0; row < numRows; ++row) {
+        copy(rows[row].begin(), rows[row].end(), tiles.begin() + row * numCols);
+    } // for
+    delete distances;
+    distances = 0;
+    findChambers();
+    findNeighbors();
+    useVectors();
+    renderBackground();
+} // assign()
+
+// see layout.h for details
+void Layout::useVectors() {
+    tileData = tiles.data();
+    chamberData = chambers.data();
+    neighborData = neighbors.data();
+    hoardData = hoards.data();
+    numHoards = hoards.size() / 2;
+} // useVectors()
+
+// see layout.h for details
+void Layout::copyData() {
+    const int area = numRows * numCols;
+    tiles.assign(tileData, tileData + area);
+    chambers.assign(chamberData, chamberData + area);
+    neighbors.assign(neighborData, neighborData + area);
+    hoards.assign(hoardData, hoardData + numHoards * 2);
+    useVectors();
+} // copyData()
+
+// see layout.h for details
+void Layout::renderBackground() {
+    background.resize((size_t) numRows * (numCols + 1));
+    string::iterator out = background.begin();
+    for (int row = 0; row < numRows; ++row) {
+        const char *tile = tileData + (size_t) row * numCols;
+        out = transform(tile, tile + numCols, out, backgroundTile);
+        *out++ = '\n';
+    } // for
+} // renderBackground()
+
+// see layout.h for details
+void Layout::findChambers() {
+    // chamber tiles not labelled yet
+    const int UNLABELLED = -2;
+    chambers.resize(numRows * numCols);
+    for (int tile = 0; tile < numRows * numCols; ++tile) {
+        chambers[tile] = isChamberTile(tiles[tile]) ? UNLABELLED : -1;
+    } // for
+
+    // flood fills from every chamber tile not reached yet
+    numChambers = 0;
+    for (int start = 0; start < numRows * numCols; ++start) {
+        if (chambers[start] != UNLABELLED) continue;
+        const int chamberNum = numChambers++;
+        chambers[start] = chamberNum;
+        pending.push_back(start);
+        while (!pending.empty()) {
+            const int tile = pending.back();
+            pending.pop_back();
+            const int tileRow = tile / numCols, tileCol = tile % numCols;
+            for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+                const int row = tileRow + ROW_OFFSETS[dir], col = tileCol + COL_OFFSETS[dir];
+                if (row < 0 || col < 0 || row >= numRows || col >= numCols) continue;
+                const int neighbor = row * numCols + col;
+                if (chambers[neighbor] != UNLABELLED) continue;
+                chambers[neighbor] = chamberNum;
+                pending.push_back(neighbor);
+            } // for
+        } // while
+    } // for
+
+    // lists the tiles of every chamber (in order)
+    if ((int) chamberTiles.size() < numChambers) chamberTiles.resize(numChambers);
+    for (int chamberNum = 0; chamberNum < numChambers; ++chamberNum) chamberTiles[chamberNum].clear();
+    for (int tile = 0; tile < numRows * numCols; ++tile) {
+        if (chambers[tile] != -1) chamberTiles[chambers[tile]].push_back(tile);
+    } // for
+
+    // keeps the original numbering if this is the original board, so that
+    // seeded games play out as they always have
+    if (numRows != NUM_ROWS || numCols != NUM_COLS || numChambers != NUM_CHAMBERS) return;
+    int original[NUM_CHAMBERS];
+    bool used[NUM_CHAMBERS];
+    for (int chamberNum = 0; chamberNum < NUM_CHAMBERS; ++chamberNum) {
+        original[chamberNum] = -1;
+        used[chamberNum] = false;
+    } // for
+    for (int chamberNum = 0; chamberNum < NUM_CHAMBERS; ++chamberNum) {
+        const vector<int> &chamber = chamberTiles[chamberNum];
+        for (vector<int>::const_iterator it = chamber.begin(); it != chamber.end(); ++it) {
+            const int num = findChamberNum(*it / numCols, *it % numCols);
+            if (num == -1 || (original[chamberNum] != -1 && num != original[chamberNum])) return;
+            original[chamberNum] = num;
+        } // for
+        if (used[original[chamberNum]]) return;
+        used[original[chamberNum]] = true;
+    } // for
+    for (int tile = 0; tile < numRows * numCols; ++tile) {
+        if (chambers[tile] != -1) chambers[tile] = original[chambers[tile]];
+    } // for
+
+    // moves every chamber's tiles into place, one cycle of the renumbering at a time
+    for (int chamberNum = 0; chamberNum < NUM_CHAMBERS; ++chamberNum) {
+        while (original[chamberNum] != chamberNum) {
+            const int target = original[chamberNum];
+            chamberTiles[chamberNum].swap(chamberTiles[target]);
+            swap(original[chamberNum], original[target]);
+        } // while
+    } // for
+} // findChambers()
+
+// see layout.h for details
+void Layout::findNeighbors() {
+    neighbors.assign(numRows * numCols, 0);
+    for (int tile = 0; tile < numRows * numCols; ++tile) {
+        if (!isWalkableTile(tiles[tile])) continue;
+        const int tileRow = tile / numCols, tileCol = tile % numCols;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            const int row = tileRow + ROW_OFFSETS[dir], col = tileCol + COL_OFFSETS[dir];
+            if (row < 0 || col < 0 || row >= numRows || col >= numCols) continue;
+            if (isWalkableTile(tiles[row * numCols + col])) neighbors[tile] |= 1 << dir;
+        } // for
+    } // for
+
+    // links every dragon with the first hoard next to it no other dragon guards
+    hoards.clear();
+    for (int tile = 0; tile < numRows * numCols; ++tile) {
+        if (tiles[tile] != 'D') continue;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            if (!(neighbors[tile] & (1 << dir))) continue;
+            const int hoard = tile + ROW_OFFSETS[dir] * numCols + COL_OFFSETS[dir];
+            if (tiles[hoard] != '9') continue;
+            bool guarded = false;
+            for (size_t i = 1; i < hoards.size(); i += 2) guarded = guarded || hoards[i] == hoard;
+            if (guarded) continue;
+            hoards.push_back(tile);
+            hoards.push_back(hoard);
+            break;
+        } // for
+    } // for
+} // findNeighbors()
+
+// see layout.h for details
+const Layout& Layout::load(const string &filename, const int floorNum) {
+    assert(1 <= floorNum && floorNum <= NUM_FLOORS);
+    lock_guard<mutex> guard(cache.lock);
+    map<string, vector<Layout *> >::iterator it = cache.files.find(filename);
+    if (it == cache.files.end()) {
+        vector<Layout *> floors;
+        readFile(filename, floors);
+        it = cache.files.insert(make_pair(filename, floors)).first;
+    } // if
+    const vector<Layout *> &floors = it->second;
+    return *floors[floors.size() == 1 ? 0 : floorNum - 1];
+} // load()
+
+// see layout.h for details
+void Layout::define(const string &name, const string &text) {
+    const char *begin = text.data(), *end = begin + text.size();
+    vector<Layout *> floors;
+    if (isCompiled(begin, end)) {
+        // (compiled boards are copied, since text does not outlive them)
+        if (!readCompiledBoards(begin, end, floors)) throw GameError();
+        for (vector<Layout *>::iterator it = floors.begin(); it != floors.end(); ++it) (*it)->copyData();
+    } else {
+        const vector<string> rows = readRows(begin, end);
+        if (rows.empty() || !addBoards(rows, floors)) throw GameError();
+    } // if
+    lock_guard<mutex> guard(cache.lock);
+    vector<Layout *> &entry = cache.files[name];
+    freeLayouts(entry);
+    entry = floors;
+} // define()
+
+// see layout.h for details
+void Layout::readFile(const string &filename, vector<Layout *> &floors) {
+    // maps the whole file
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) throw InvalidFile();
+    struct stat info;
+    void *mapping = NULL;
+    size_t size = 0;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        size = info.st_size;
+        mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    } // if
+    close(fd);
+    if (mapping == MAP_FAILED) throw InvalidFile();
+    const char *begin = (const char *) mapping, *end = begin + size;
+
+    // uses the boards of a compiled file as they are mapped
+    if (isCompiled(begin, end)) {
+        if (!readCompiledBoards(begin, end, floors)) {
+            munmap(mapping, size);
+            cerr << "Compiled configuration file " << filename << " is corrupt or out of date." << endl;
+            throw GameError();
+        } // if
+        floors[0]->mapping = mapping;
+        floors[0]->mappingSize = size;
+        return;
+    } // if
+
+    // otherwise, parses its rows
+    const vector<string> rows = readRows(begin, end);
+    if (mapping) munmap(mapping, size);
+    if (rows.empty()) {
+        cerr << "Configuration file " << filename << " is empty." << endl;
+        throw GameError();
+    } // if
+    if (!addBoards(rows, floors)) {
+        cerr << "Configuration file " << filename << " must hold one board, or " << NUM_FLOORS
+             << " boards separated by lines starting with '" << FLOOR_SEPARATOR << "'." << endl;
+        throw GameError();
+    } // if
+} // readFile()
+
+// see layout.h for details
+bool Layout::readCompiledBoards(const char *begin, const char *end, vector<Layout *> &floors) {
+    const char *p = begin;
+    while (p != end) {
+        Layout *layout = readCompiled(p, end);
+        if (!layout) break;
+        floors.push_back(layout);
+    } // while
+    if (p == end && (floors.size() == 1 || floors.size() == (size_t) NUM_FLOORS)) return true;
+    freeLayouts(floors);
+    return false;
+} // readCompiledBoards()
+
+// see layout.h for details
+Layout* Layout::readCompiled(const char *&p, const char *end) {
+    // the board must fit in the file, and match its checksum
+    if ((size_t) (end - p) < sizeof(CompiledHeader)) return NULL;
+    const CompiledHeader &header = *(const CompiledHeader *) p;
+    if (memcmp(header.magic, COMPILED_MAGIC, sizeof(COMPILED_MAGIC)) != 0
+        || header.version != COMPILED_VERSION
+        || header.numRows <= 0 || header.numRows > MAX_COMPILED_DIMENSION
+        || header.numCols <= 0 || header.numCols > MAX_COMPILED_DIMENSION
+        || header.numChambers < 0 || header.numChambers > header.numRows * header.numCols
+        || header.numHoards < 0 || header.numHoards > header.numRows * header.numCols) return NULL;
+    const Sections s = sections(header.numRows, header.numCols, header.numHoards);
+    if ((size_t) (end - p) < s.size) return NULL;
+#ifndef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+    // (the fuzzers skip it, so that their mutations reach the checks below)
+    if (checksum(p + sizeof(CompiledHeader), p + s.size) != header.checksum) return NULL;
+#endif
+
+    Layout *layout = new Layout();
+    layout->numRows = header.numRows;
+    layout->numCols = header.numCols;
+    layout->numChambers = header.numChambers;
+    layout->tileData = p + s.tiles;
+    layout->chamberData = (const int *) (p + s.chambers);
+    layout->neighborData = (const unsigned char *) (p + s.neighbors);
+    layout->hoardData = (const int *) (p + s.hoards);
+    layout->numHoards = header.numHoards;
+
+    if (!layout->isConsistent()) {
+        delete layout;
+        return NULL;
+    } // if
+
+    // lists the tiles of every chamber (in order)
+    layout->chamberTiles.resize(layout->numChambers);
+    for (int tile = 0; tile < layout->numRows * layout->numCols; ++tile) {
+        const int chamberNum = layout->chamberData[tile];
+        if (chamberNum != -1) layout->chamberTiles[chamberNum].push_back(tile);
+    } // for
+    layout->renderBackground();
+    p += aligned(s.size);
+    if (p > end) p = end;
+    return layout;
+} // readCompiled()
+
+// see layout.h for details
+bool Layout::isConsistent() const {
+    // every chamber tile (floor, stairs, or anything standing on the floor) is
+    // in a chamber, and nothing else is
+    const int area = numRows * numCols;
+    for (int tile = 0; tile < area; ++tile) {
+        const int chamberNum = chamberData[tile];
+        if (isChamberTile(tileData[tile]) ? chamberNum < 0 || chamberNum >= numChambers : chamberNum != -1) return false;
+    } // for
+
+    // only walkable tiles have neighbors, which are walkable tiles on the board
+    for (int tile = 0; tile < area; ++tile) {
+        if (neighborData[tile] && !isWalkableTile(tileData[tile])) return false;
+        const int tileRow = tile / numCols, tileCol = tile % numCols;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            if (!(neighborData[tile] & (1 << dir))) continue;
+            const int row = tileRow + ROW_OFFSETS[dir], col = tileCol + COL_OFFSETS[dir];
+            if (row < 0 || col < 0 || row >= numRows || col >= numCols) return false;
+            if (!isWalkableTile(tileData[row * numCols + col])) return false;
+        } // for
+    } // for
+
+    // every dragon guards a hoard next to it that no other dragon guards, and
+    // dragons are sorted by tile
+    vector<bool> guarded(area, false);
+    for (int i = 0; i < numHoards; ++i) {
+        const int dragon = hoardData[i * 2], hoard = hoardData[i * 2 + 1];
+        if (dragon < 0 || dragon >= area || hoard < 0 || hoard >= area) return false;
+        if (i > 0 && dragon <= hoardData[i * 2 - 2]) return false;
+        if (tileData[dragon] != 'D' || tileData[hoard] != '9' || guarded[hoard]) return false;
+        const int rowOffset = hoard / numCols - dragon / numCols, colOffset = hoard % numCols - dragon % numCols;
+        if (rowOffset < -1 || rowOffset > 1 || colOffset < -1 || colOffset > 1) return false;
+        guarded[hoard] = true;
+    } // for
+    return true;
+} // isConsistent()
+
+// see layout.h for details
+bool Layout::compile(const string &config, const string &output) {
+    // (files of a single board get the same layout for every floor)
+    string image;
+    const Layout *previous = NULL;
+    for (int floorNum = 1; floorNum <= NUM_FLOORS; ++floorNum) {
+        const Layout &layout = load(config, floorNum);
+        if (&layout == previous) break;
+        previous = &layout;
+
+        const size_t area = (size_t) layout.numRows * layout.numCols;
+        const Sections s = sections(layout.numRows, layout.numCols, layout.numHoards);
+        const size_t start = image.size();
+        image.resize(start + aligned(s.size), '\0');
+        char *board = &image[start];
+        memcpy(board + s.tiles, layout.tileData, area);
+        memcpy(board + s.chambers, layout.chamberData, area * sizeof(int32_t));
+        memcpy(board + s.neighbors, layout.neighborData, area);
+        if (layout.numHoards) memcpy(board + s.hoards, layout.hoardData, layout.numHoards * 2 * sizeof(int32_t));
+
+        CompiledHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, COMPILED_MAGIC, sizeof(COMPILED_MAGIC));
+        header.version = COMPILED_VERSION;
+        header.numRows = layout.numRows;
+        header.numCols = layout.numCols;
+        header.numChambers = layout.numChambers;
+        header.numHoards = layout.numHoards;
+        header.checksum = checksum(board + sizeof(CompiledHeader), board + s.size);
+        memcpy(board, &header, sizeof(header));
+    } // for
+
+    ofstream out(output.c_str(), ios::binary);
+    if (!out.good()) return false;
+    out.write(image.data(), image.size());
+    return out.good();
+} // compile()
+
+// see layout.h for details
+int Layout::getNumRows() const {
+    return numRows;
+} // getNumRows()
+
+// see layout.h for details
+int Layout::getNumCols() const {
+    return numCols;
+} // getNumCols()
+
+// see layout.h for details
+char Layout::at(const int row, const int col) const {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    return tileData[row * numCols + col];
+} // at()
+
+// see layout.h for details
+int Layout::getChamberNum(const int row, const int col) const {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    return chamberData[row * numCols + col];
+} // getChamberNum()
+
+// see layout.h for details
+int Layout::getNumChambers() const {
+    return numChambers;
+} // getNumChambers()
+
+// see layout.h for details
+const vector<int>& Layout::getChamberTiles(const int chamberNum) const {
+    assert(0 <= chamberNum && chamberNum < numChambers);
+    return chamberTiles[chamberNum];
+} // getChamberTiles()
+
+// see layout.h for details
+bool Layout::isWalkable(const int row, const int col) const {
+    if (row < 0 || col < 0 || row >= numRows || col >= numCols) return false;
+    return isWalkableTile(at(row, col));
+} // isWalkable()
+
+// see layout.h for details
+int Layout::getNeighbors(const int row, const int col) const {
+    assert(0 <= row && row < numRows && 0 <= col && col < numCols);
+    return neighborData[row * numCols + col];
+} // getNeighbors()
+
+// see layout.h for details
+int Layout::getHoard(const int row, const int col) const {
+    const int tile = row * numCols + col;
+    int low = 0, high = numHoards;
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (hoardData[middle * 2] < tile) low = middle + 1;
+        else high = middle;
+    } // while
+    return (low < numHoards && hoardData[low * 2] == tile) ? hoardData[low * 2 + 1] : -1;
+} // getHoard()
+
+// see layout.h for details
+const string& Layout::getBackground() const {
+    return background;
+} // getBackground()
+
+// see layout.h for details
+const DistanceTable& Layout::getDistances() const {
+    lock_guard<mutex> guard(distancesLock);
+    if (!distances) distances = new DistanceTable(*this);
+    return *distances;
+} // getDistances()
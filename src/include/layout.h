@@ -0,0 +1,285 @@
+#ifndef __LAYOUT_H__
+#define __LAYOUT_H__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <mutex>
+
+class DistanceTable;
+
+/*******************************************************************************
+ * Layout is the parsed (static) part of a floor configuration: its tiles,
+ * chambers, walkable neighbors and the hoards its dragons guard
+ * notes: a configuration file holds one board for every floor, or one board
+ *        per floor (see load())
+ *        a configuration may also be compiled (see compile()) into a binary
+ *        file that load() maps into memory as is, without parsing it
+ * *****************************************************************************/
+class Layout {
+    // dimensions of the board
+    int numRows, numCols;
+
+    // configuration characters, row by row
+    std::vector<char> tiles;
+
+    // chamber of every tile (-1 for tiles outside chambers)
+    std::vector<int> chambers;
+
+    // walkable neighbors of every walkable tile, one bit per direction (in the
+    // order of DIRECTIONS)
+    std::vector<unsigned char> neighbors;
+
+    // dragons and the hoards they guard, as a dragon tile followed by its 
+    // hoard's tile, sorted by dragon tile (dragons without a hoard are left out)
+    std::vector<int> hoards;
+
+    // tiles, chambers, neighbors and hoards actually used: the vectors above,
+    // or the mapping of a compiled configuration
+    const char *tileData;
+    const int *chamberData;
+    const unsigned char *neighborData;
+    const int *hoardData;
+    int numHoards;
+
+    // compiled configuration mapped into memory (NULL if none), and its size
+    // (the layouts of the other floors of the file point into it as well)
+    void *mapping;
+    size_t mappingSize;
+
+    // tiles of every chamber, as row * numCols + col
+    // (only the first numChambers are used; the others are kept to be reused)
+    int numChambers;
+    std::vector<std::vector<int> > chamberTiles;
+
+    // shortest distances between walkable tiles (NULL until first requested),
+    // and the lock under which they are built (layouts are shared by threads)
+    mutable DistanceTable *distances;
+    mutable std::mutex distancesLock;
+
+    // the board as printed without its occupants (see getBackground())
+    std::string background;
+
+    // scratch space for findChambers() (kept to avoid reallocations)
+    std::vector<int> pending;
+
+    /*******************************************************************************
+     * findChambers() numbers the chambers of the layout
+     * notes: a chamber is a group of connected floor tiles (including stairs and
+     *        anything standing on the floor)
+     *        chambers of the original board get their original numbers;
+     *        otherwise, chambers are numbered in the order of their first tile
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    void findChambers();
+
+    /*******************************************************************************
+     * findNeighbors() finds the walkable neighbors of every walkable tile, and
+     *  the hoard every dragon guards
+     * notes: every dragon (in reading order) guards the first hoard next to it
+     *        (in the order of DIRECTIONS) that no other dragon guards
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    void findNeighbors();
+
+    // makes the data pointers point into the vectors
+    void useVectors();
+
+    // copies the data the layout uses into its vectors (for compiled boards
+    // that must outlive the image they were read from)
+    void copyData();
+
+    // renders the background from the tiles
+    void renderBackground();
+
+    /*******************************************************************************
+     * isConsistent() determines if the chambers, neighbors and hoards of the
+     *  layout agree with its tiles (as findChambers() and findNeighbors() would
+     *  find them)
+     * notes: compiled boards are checked before use, since a board that passes
+     *        its checksum may still index outside the floor's tables
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    bool isConsistent() const;
+
+    /*******************************************************************************
+     * readFile(filename, floors) adds the layouts of the boards in configuration
+     *  file filename to floors, mapping the file into memory
+     * notes: the layouts of a compiled file point into the mapping, which the
+     *        first one owns; otherwise, the file is unmapped once it is parsed
+     * exceptions: throws InvalidFile() if filename cannot be read, GameError()
+     *             if it contains no rows, or is compiled but corrupt or by
+     *             another version
+     * time: O(size of file)
+     * *****************************************************************************/
+    static void readFile(const std::string &filename, std::vector<Layout *> &floors);
+
+    /*******************************************************************************
+     * readCompiled(p, end) gets the layout of the compiled board at p (in a file 
+     *  mapped into memory up to end), moving p past it
+     * notes: returns NULL if the board is corrupt or by another version
+     * time: O(size of board) (to verify its checksum)
+     * *****************************************************************************/
+    static Layout* readCompiled(const char *&p, const char *end);
+
+    /*******************************************************************************
+     * readCompiledBoards(begin, end, floors) adds the layouts of the compiled
+     *  boards between begin and end to floors
+     * notes: returns false (adding nothing) unless there is one board, or one
+     *        per floor, and none is corrupt or by another version
+     *        the layouts point into the boards, which they do not own
+     * time: O(end - begin)
+     * *****************************************************************************/
+    static bool readCompiledBoards(const char *begin, const char *end, std::vector<Layout *> &floors);
+
+    // creates an empty layout (to be mapped)
+    Layout();
+
+    // layouts are shared, so they cannot be copied
+    Layout(const Layout &other);
+    Layout& operator= (const Layout &other);
+
+  public:
+    /*******************************************************************************
+     * Layout constructor creates a layout from the rows of a configuration
+     * notes: layouts of configuration files must be obtained through load();
+     *        layouts constructed directly are owned by the caller
+     *        the board is as wide as the longest row; shorter rows are padded
+     *        with empty space
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    explicit Layout(const std::vector<std::string> &rows);
+
+    ~Layout();
+
+    /*******************************************************************************
+     * assign(rows) makes this the layout of the configuration with rows
+     * notes: reuses the storage of the layout
+     *        must not be used on layouts obtained through load()
+     * time: O(numRows * numCols)
+     * *****************************************************************************/
+    void assign(const std::vector<std::string> &rows);
+
+    /*******************************************************************************
+     * load(filename, floorNum) gets the layout of floor floorNum stored in 
+     *  configuration file filename
+     * notes: a file holds a single board, used on every floor, or a board
+     *        for every floor, one after another, each after the first 
+     *        starting below a separator line (a line starting with '=')
+     *        each file is mapped into memory and split into boards once; 
+     *        later calls return the same layouts
+     *        compiled files (see compile()) are used as they are mapped
+     *        may be called from any thread
+     * required: 1 <= floorNum <= NUM_FLOORS
+     * exceptions: throws InvalidFile() if filename cannot be read,
+     *             GameError() if it contains no rows, holds neither one board
+     *             nor one per floor, or is compiled but invalid
+     * time: O(size of file) the first time, O(log #files) afterwards
+     * *****************************************************************************/
+    static const Layout& load(const std::string &filename, const int floorNum = 1);
+
+    /*******************************************************************************
+     * define(name, text) makes the configuration in text (one or NUM_FLOORS 
+     *  boards, as in a file, possibly compiled) the one load(name) gets, in
+     *  place of the file name (or of the configuration defined before)
+     * notes: lets configurations be played without being written to files 
+     *        (e.g. by the fuzzers)
+     *        compiled boards are copied out of text
+     * required: no floor uses the layouts load(name) got before
+     * exceptions: throws GameError() if text contains no rows, holds neither
+     *             one board nor one per floor, or is compiled but invalid
+     * time: O(|text|)
+     * *****************************************************************************/
+    static void define(const std::string &name, const std::string &text);
+
+    /*******************************************************************************
+     * compile(config, output) writes the boards of configuration file config to
+     *  output in compiled form: every board as a versioned header and checksum,
+     *  followed by its tiles, chambers, neighbors and hoards as load() maps them
+     * notes: returns false if output cannot be written
+     *        compiled files are only read on machines of the same byte order
+     * exceptions: see load()
+     * time: O(size of config)
+     * *****************************************************************************/
+    static bool compile(const std::string &config, const std::string &output);
+
+    // getter for numRows
+    int getNumRows() const;
+
+    // getter for numCols
+    int getNumCols() const;
+
+    /*******************************************************************************
+     * at(row, col) gets the configuration character at (row, col)
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(1)
+     * *****************************************************************************/
+    char at(const int row, const int col) const;
+
+    /*******************************************************************************
+     * getChamberNum(row, col) gets the chamber the tile at (row, col) is in
+     * notes: returns -1 if the tile is not in a chamber
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(1)
+     * *****************************************************************************/
+    int getChamberNum(const int row, const int col) const;
+
+    // getter for the number of chambers
+    int getNumChambers() const;
+
+    /*******************************************************************************
+     * getChamberTiles(chamberNum) gets the tiles of chamber chamberNum, 
+     *  as row * numCols + col
+     * required: 0 <= chamberNum < getNumChambers()
+     * time: O(1)
+     * *****************************************************************************/
+    const std::vector<int>& getChamberTiles(const int chamberNum) const;
+
+    /*******************************************************************************
+     * isWalkable(row, col) determines if the tile at (row, col) is walkable 
+     *  (floor, doorway, passageway, stairs or anything standing on the floor)
+     * notes: returns false if (row, col) is out of bounds
+     * time: O(1)
+     * *****************************************************************************/
+    bool isWalkable(const int row, const int col) const;
+
+    /*******************************************************************************
+     * getNeighbors(row, col) gets the walkable neighbors of the tile at 
+     *  (row, col), one bit per direction (in the order of DIRECTIONS)
+     * notes: returns 0 if the tile is not walkable
+     * required: 0 <= row < numRows, 0 <= col < numCols
+     * time: O(1)
+     * *****************************************************************************/
+    int getNeighbors(const int row, const int col) const;
+
+    /*******************************************************************************
+     * getHoard(row, col) gets the tile (as row * numCols + col) of the hoard 
+     *  the dragon at (row, col) guards
+     * notes: returns -1 if there is no dragon at (row, col), or if it has no 
+     *        hoard next to it that another dragon does not guard
+     * time: O(log #dragons)
+     * *****************************************************************************/
+    int getHoard(const int row, const int col) const;
+
+    /*******************************************************************************
+     * getBackground() gets the board as printed with nothing standing on it: 
+     *  numRows rows of numCols characters, each followed by a newline, in which
+     *  every tile an item or a character starts on is a floor tile
+     * notes: walls, doorways, passageways, stairs and empty space never change
+     *        during a floor, so a floor is printed by copying its background
+     *        and writing its occupants over it (see Floor)
+     * time: O(1)
+     * *****************************************************************************/
+    const std::string& getBackground() const;
+
+    /*******************************************************************************
+     * getDistances() gets the shortest distances between walkable tiles
+     * notes: the table is built the first time it is requested (once, even if
+     *        several threads request it at once)
+     * time: O(min(#walkable tiles, MAX_DISTANCE_TABLE_TILES)^2) the first time, 
+     *       O(1) afterwards
+     * *****************************************************************************/
+    const DistanceTable& getDistances() const;
+};
+
+#endif
@@ -7,7 +7,7 @@ void printRaces();
 // prints info for possible enemies
 void printEnemies();
 
-// prints available commands
+// prints available commands (p only while recording turn statistics)
 void printCommands();
 
 // prints help options
@@ -10,15 +10,18 @@
 #include "game.h"
 #include "item.h"
 #include "constants.h"
+#include "rng.h"
 #include "enemy.h"
 #include "cell.h"
+#include "console.h"
 
 using namespace std;
 using namespace constants;
 
 // constructor
-PC::PC(const string race, const int maxHp, const int hp, const int atk, 
-       const int def, const string ability): Player(race, maxHp, hp,atk,def, '@',ability) {}
+PC::PC(const Race race, const int maxHp, const int hp, const int atk, 
+       const int def): Player(race, maxHp, hp,atk,def, '@'), 
+       merchantsHostile(false) {}
 
 // see pc.h for details
 void PC::modifyHP(const int amount) {
@@ -30,7 +33,7 @@ void PC::modifyHP(const int amount) {
 
 // see pc.h for details
 void PC::dodgesAttack(Player &attacker) {
-    if (rand() % PC_DODGE_DENOM) {
+    if (Rng::current().next() % PC_DODGE_DENOM) {
         addAction("Player character dodges attack");
         throw AttackDodged();
     } // if
@@ -93,6 +96,21 @@ void PC::attackInDirection(const string dir) {
     } // catch
 } // PC::attackInDirection
 
+// see pc.h for details
+Merchant& PC::findTargetMerchantTrade(const string dir) {
+    // get corresponding cell from list of neighbors
+    Cell *target = location->getNeighbor(dir);
+
+    // cannot trade with a cell that is not walkable or is not occupied 
+    // by character
+    if (!target || !target->isOccupiedByCharacter()) throw NonMerchant();
+
+    // see if character is interested in trading
+    target->getEnemy()->initiateTalks(*this);
+
+    return *((Merchant *) target->getEnemy());
+} // PC::findTargetMerchantTrade()
+
 // see pc.h for details
 void PC::trade(const string dir) {
     Merchant &merchant = findTargetMerchantTrade(dir);
@@ -102,8 +120,9 @@ void PC::trade(const string dir) {
         merchant.printInventory();
 
         // gets user command
-        cout << "Enter your choice or r to return to the game." << endl;
-        cin >> cmd;
+        Console::out() << "Enter your choice or r to return to the game." << endl;
+        // (the end of the input returns to the game)
+        if (!Console::read(cmd)) cmd = 'r';
 
         if (cmd == 'r') throw Merchant::NoDeal();
 
@@ -113,7 +132,7 @@ void PC::trade(const string dir) {
             // if successful, finish the trade
             return;
         } catch (Merchant::InvalidChoice &e) {
-            cout << "Invalid choice. Please try again." << endl;
+            Console::out() << "Invalid choice. Please try again." << endl;
         } // catch
     } while (1);
 } // trade()
@@ -128,6 +147,16 @@ void PC::vanquishEnemy(Enemy &enemy, const string dir) {
     enemy.getLocation()->enemyDies();
 } // vanquishEnemy()
 
+// see pc.h for details
+bool PC::areMerchantsHostile() const {
+    return merchantsHostile;
+} // areMerchantsHostile()
+
+// see pc.h for details
+void PC::makeMerchantsHostile() {
+    merchantsHostile = true;
+} // makeMerchantsHostile()
+
 // see pc.h for details
 void PC::stealGold(){}
 
@@ -188,15 +217,15 @@ PC *createRace(const char c) {
 
 /******************************* PC Race Constructors ************************************/
 
-Shade::Shade(): PC("Shade", SHADE_HP, SHADE_HP, SHADE_ATK, SHADE_DEF, SHADE_ABILITY) {}
+Shade::Shade(): PC(SHADE, SHADE_HP, SHADE_HP, SHADE_ATK, SHADE_DEF) {}
 
-Drow::Drow(): PC("Drow", DROW_HP, DROW_HP, DROW_ATK, DROW_DEF, DROW_ABILITY) {}
+Drow::Drow(): PC(DROW, DROW_HP, DROW_HP, DROW_ATK, DROW_DEF) {}
 
-Vampire::Vampire(): PC("Vampire", INT32_MAX, VAMP_HP, VAMP_ATK, VAMP_DEF, VAMP_ABILITY) {}
+Vampire::Vampire(): PC(VAMPIRE, INT32_MAX, VAMP_HP, VAMP_ATK, VAMP_DEF) {}
 
-Troll::Troll(): PC("Troll", TROLL_HP, TROLL_HP, TROLL_ATK, TROLL_DEF, TROLL_ABILITY) {}
+Troll::Troll(): PC(TROLL, TROLL_HP, TROLL_HP, TROLL_ATK, TROLL_DEF) {}
 
-Goblin::Goblin(): PC("Goblin", GOBLIN_HP, GOBLIN_HP, GOBLIN_ATK, GOBLIN_DEF, GOBLIN_ABILITY) {}
+Goblin::Goblin(): PC(GOBLIN, GOBLIN_HP, GOBLIN_HP, GOBLIN_ATK, GOBLIN_DEF) {}
 
 /************************** Race-Specific Overloaded Methods ********************************/
 // see pc.h for details
@@ -9,14 +9,17 @@ class Orc;
 class Elf;
 
 class PC : public Player {
+    // have the merchants turned hostile to this PC? (see Merchant::makeHostile())
+    bool merchantsHostile;
+
   protected:
     /*******************************************************************************
      * PC constructor
      * notes: a PC cannot be constructed directly; must use factory method
      * time: O(1)
      * *****************************************************************************/
-    PC(const std::string race, const int maxHp, const int hp, 
-       const int atk, const int def, const std::string ability = "");
+    PC(const constants::Race race, const int maxHp, const int hp, 
+       const int atk, const int def);
 
     /*******************************************************************************
      * PCAttackPrep(dir) prepares a PC attack on cell in direction dir, returns
@@ -31,6 +34,14 @@ class PC : public Player {
      * *****************************************************************************/  
     Enemy& PCAttackPrep(const std::string dir);
 
+    /*******************************************************************************
+     * findTargetMerchantTrade(dir) tries to get Merchant for trading PC in
+     *  direction dir
+     * exceptions: may throw NonMerchant() or NotInterested() as appropriate
+     * time: O(#neighbors of PC's location)
+     * *****************************************************************************/
+    Merchant& findTargetMerchantTrade(const std::string dir);
+
   public:
     // exception to be thrown when selected race is invalid
     class NotPCRace : public GameException {};
@@ -95,6 +106,12 @@ class PC : public Player {
      * *****************************************************************************/
     void vanquishEnemy(Enemy &enemy, const std::string dir);
 
+    // getter for whether the merchants are hostile to this PC
+    bool areMerchantsHostile() const;
+
+    // makes the merchants hostile to this PC (see Merchant::makeHostile())
+    void makeMerchantsHostile();
+
     /*******************************************************************************
      * stealGold() determines, based on pc run-time type, if it steals gold from
      *  slain enemy
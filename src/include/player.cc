@@ -12,20 +12,31 @@
 #include "player.h"
 #include "enemy.h"
 #include "pc.h"
+#include "pool.h"
 
 using namespace std; 
 
 // see player.h for details
-Player::Player(const string race, const int maxHp, const int hp, const int atk, 
-               const int def, const char token, const std::string ability)
+Player::Player(const constants::Race race, const int maxHp, const int hp, const int atk, 
+               const int def, const char token)
                 : race(race), maxHp(maxHp), hp(hp), atk(atk), def(def), gold(0), 
-                    token(token), ability(ability), location(0), decorators(0) {}
+                    token(token), location(0), decorators(0) {}
 
 // see player.h for details
 Player::~Player(){
     delete decorators;
 }
 
+// see player.h for details
+void* Player::operator new(size_t size) {
+    return Pool::allocate(size);
+} // operator new
+
+// see player.h for details
+void Player::operator delete(void *p, size_t size) {
+    Pool::release(p, size);
+} // operator delete
+
 // see player.h for details
 void Player::addAction (const string action) {
     actions.push_back(action);
@@ -144,27 +155,13 @@ Cell& Player::findTargetCellAttack(const string dir) {
     return *target;
 } // Player::attackInDirection()
 
-// see player.h for details
-Merchant& Player::findTargetMerchantTrade(const string dir) {
-    // get corresponding cell from list of neighbors
-    Cell *target = location->getNeighbor(dir);
-
-    // cannot trade with a cell that is not walkable or is not occupied 
-    // by character
-    if (!target || !target->isOccupiedByCharacter()) throw NonMerchant();
-
-    // see if character is interested in trading
-    target->getEnemy()->initiateTalks();
-
-    return *((Merchant *) target->getEnemy());
-} // Player::attackInDirection()
 
 // see player.h for details
 ostream& operator<< (ostream& out, Player &p){
     // prints stats
     out << left << setw(9) << "Gold: " << p.gold << "\t"
-        << setw(9) << "Race: " << p.race;
-    if (p.ability != "") out << " (" << p.ability << ")";
+        << setw(9) << "Race: " << constants::RACES[p.race].name 
+        << " (" << constants::RACES[p.race].ability << ")";
     out << endl;
     out << left << setw(9) << "HP: " << p.hp << "\t"
         << setw(9) << "Atk: " << p.getAtk() << "\t"
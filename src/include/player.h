@@ -4,9 +4,11 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <cstddef>
 #include <exception>
 #include "potionDecorator.h"
 #include "game.h"
+#include "constants.h"
 
 class Cell;
 class PC;
@@ -15,14 +17,14 @@ class Merchant;
 
 class Player {
   protected:
-    const std::string race;
+    // (the race's name and ability are in constants::RACES)
+    const constants::Race race;
     const int maxHp;
     int hp;
     int atk;
     int def;
     int gold;
     const char token;
-    const std::string ability;
 
     Cell *location;
 
@@ -36,8 +38,8 @@ class Player {
      * notes: a Player cannot be constructed directly; must use factory method
      * time: O(1)
      * *****************************************************************************/
-    Player(const std::string race, const int maxHp, const int hp, const int atk, 
-            const int def, const char token, const std::string ability = "");
+    Player(const constants::Race race, const int maxHp, const int hp, const int atk, 
+            const int def, const char token);
     
     /*******************************************************************************
      * Player destructor frees potion decorators
@@ -48,6 +50,13 @@ class Player {
            
   public: 
 
+    /*******************************************************************************
+     * operator new/delete take enemies (and the PC) from the object pool (see pool.h), 
+     *  since they are created and freed with every floor
+     * *****************************************************************************/
+    static void* operator new(std::size_t size);
+    static void operator delete(void *p, std::size_t size);
+
     /*******************************************************************************
      * addAction(action) adds action to end of queue of actions
      * time : O(1)
@@ -168,14 +177,6 @@ class Player {
      * *****************************************************************************/
     Cell& findTargetCellAttack(const std::string dir);
 
-    /*******************************************************************************
-     * findTargetMerchantTrade(dir) tries to get Merchant for trading player in
-     *  direction dir
-     * exceptions: may throw NonMerchant() or HostileTrader() as appropriate
-     * time: O(#neighbors of this player's cell)
-     * *****************************************************************************/
-    Merchant& findTargetMerchantTrade(const std::string dir);
-
     /*******************************************************************************
      * operator<< prints hp, atk, def, gold stats and buffer of actions
      * time : O(#actions)
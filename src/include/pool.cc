@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * pool.cc
+ * 
+ * Module implementing the pool recycling the storage of game objects.
+ * ****************************************************************************/
+
+#include <new>
+#include <mutex>
+#include "pool.h"
+
+using namespace std;
+
+namespace {
+    // sizes are rounded up to a multiple of GRANULARITY
+    const size_t GRANULARITY = 16;
+    const size_t NUM_CLASSES = Pool::MAX_POOLED_SIZE / GRANULARITY;
+
+    // number of objects whose storage is taken from the heap at once, and
+    // passed between threads at once
+    const size_t OBJECTS_PER_SLAB = 64;
+
+    // most released objects of a size class a thread keeps to itself
+    const size_t MAX_CACHED = 2 * OBJECTS_PER_SLAB;
+
+    // released storage, linked through its first word into the free list of a
+    // thread, or into a batch; the first block of a batch links it to the
+    // next batch through its second word
+    struct FreeBlock {
+        FreeBlock *next;
+        FreeBlock *nextBatch;
+    };
+    static_assert(sizeof(FreeBlock) <= GRANULARITY, "free blocks must fit in the smallest objects");
+
+    // batches of released storage of a size class that no thread keeps, each
+    // size class under its own lock (taken once per batch)
+    struct SharedBatches {
+        mutex lock;
+        FreeBlock *first;
+
+        SharedBatches() : first(NULL) {}
+    };
+    SharedBatches shared[NUM_CLASSES];
+
+    // released storage of every size class kept by the calling thread, and
+    // how much of it
+    struct ThreadCache {
+        FreeBlock *blocks[NUM_CLASSES];
+        size_t counts[NUM_CLASSES];
+
+        ThreadCache();
+        ~ThreadCache();
+    };
+
+    // set once the calling thread's cache is gone (as the thread exits), after
+    // which it uses the shared batches directly
+    thread_local bool cacheGone = false;
+
+    // size class of objects of size bytes
+    size_t sizeClass(const size_t size) {
+        return (size + GRANULARITY - 1) / GRANULARITY - 1;
+    } // sizeClass()
+
+    // adds batch to the shared batches of size class c
+    void pushBatch(const size_t c, FreeBlock *batch) {
+        lock_guard<mutex> guard(shared[c].lock);
+        batch->nextBatch = shared[c].first;
+        shared[c].first = batch;
+    } // pushBatch()
+
+    // takes a shared batch of size class c (NULL if there is none)
+    FreeBlock* popBatch(const size_t c) {
+        lock_guard<mutex> guard(shared[c].lock);
+        FreeBlock *batch = shared[c].first;
+        if (batch) shared[c].first = batch->nextBatch;
+        return batch;
+    } // popBatch()
+
+    // carves a new slab into a batch of OBJECTS_PER_SLAB blocks of size class c
+    FreeBlock* newBatch(const size_t c) {
+        const size_t blockSize = (c + 1) * GRANULARITY;
+        char *slab = static_cast<char *>(::operator new(blockSize * OBJECTS_PER_SLAB));
+        FreeBlock *batch = NULL;
+        for (size_t i = 0; i < OBJECTS_PER_SLAB; ++i) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(slab + i * blockSize);
+            block->next = batch;
+            batch = block;
+        } // for
+        return batch;
+    } // newBatch()
+
+    // constructor
+    ThreadCache::ThreadCache() {
+        for (size_t c = 0; c < NUM_CLASSES; ++c) {
+            blocks[c] = NULL;
+            counts[c] = 0;
+        } // for
+    } // ThreadCache ctor
+
+    // hands what the thread kept back to the other threads
+    ThreadCache::~ThreadCache() {
+        for (size_t c = 0; c < NUM_CLASSES; ++c) {
+            if (blocks[c]) pushBatch(c, blocks[c]);
+        } // for
+        cacheGone = true;
+    } // ThreadCache dtor
+
+    // gets the calling thread's cache
+    ThreadCache& threadCache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    } // threadCache()
+} // namespace
+
+const size_t Pool::MAX_POOLED_SIZE;
+
+// see pool.h for details
+void* Pool::allocate(const size_t size) {
+    if (size == 0 || size > MAX_POOLED_SIZE) return ::operator new(size);
+    const size_t c = sizeClass(size);
+    if (cacheGone) return ::operator new((c + 1) * GRANULARITY);
+
+    // takes a shared batch (or a new one) when the thread has nothing left
+    ThreadCache &cache = threadCache();
+    if (!cache.blocks[c]) {
+        FreeBlock *batch = popBatch(c);
+        cache.blocks[c] = batch ? batch : newBatch(c);
+        for (FreeBlock *block = cache.blocks[c]; block; block = block->next) ++cache.counts[c];
+    } // if
+    FreeBlock *block = cache.blocks[c];
+    cache.blocks[c] = block->next;
+    --cache.counts[c];
+    return block;
+} // allocate()
+
+// see pool.h for details
+void Pool::release(void *p, const size_t size) {
+    if (!p) return;
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(p);
+        return;
+    } // if
+    const size_t c = sizeClass(size);
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    if (cacheGone) {
+        block->next = NULL;
+        pushBatch(c, block);
+        return;
+    } // if
+
+    // hands a batch to the other threads when the thread keeps too much
+    ThreadCache &cache = threadCache();
+    block->next = cache.blocks[c];
+    cache.blocks[c] = block;
+    if (++cache.counts[c] < MAX_CACHED) return;
+    FreeBlock *last = block;
+    for (size_t i = 1; i < OBJECTS_PER_SLAB; ++i) last = last->next;
+    cache.blocks[c] = last->next;
+    last->next = NULL;
+    cache.counts[c] -= OBJECTS_PER_SLAB;
+    pushBatch(c, block);
+} // release()
@@ -0,0 +1,32 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <cstddef>
+
+class Pool {
+  public:
+    // objects larger than this are not pooled
+    static const std::size_t MAX_POOLED_SIZE = 256;
+
+    /*******************************************************************************
+     * allocate(size) gets storage for an object of size bytes
+     * notes: reuses the storage of released objects of similar size; new
+     *        storage is only taken from the heap when there is none left
+     *        may be called from any thread: every thread keeps the storage it
+     *        releases for its own allocations, and passes it to other threads
+     *        (under a lock per size class) a slab's worth at a time
+     * time: O(1) amortized
+     * *****************************************************************************/
+    static void* allocate(const std::size_t size);
+
+    /*******************************************************************************
+     * release(p, size) makes the storage at p, of an object of size bytes, 
+     *  available to later allocations
+     * required: p was returned by allocate(size) and not released since
+     *           (or p is NULL)
+     * time: O(1)
+     * *****************************************************************************/
+    static void release(void *p, const std::size_t size);
+};
+
+#endif
@@ -12,13 +12,13 @@ using namespace std;
 using namespace constants;
 
 // constructors for potion types
-Potion::Potion(string effect) : Item('P'), effect(effect) {}
-RH::RH(): Potion ("restore up to " + to_string(RH_HP_VALUE) + " HP") {}
-BA::BA(): Potion ("increase ATK by " + to_string(BA_ATK_VALUE)) {}
-BD::BD(): Potion ("increase Def by " + to_string(BD_DEF_VALUE)) {}
-PH::PH(): Potion ("lose up to " + to_string(-PH_HP_VALUE) + " HP") {}
-WA::WA(): Potion ("decrease Atk by " + to_string(-WA_ATK_VALUE)) {}
-WD::WD(): Potion ("decrease Def by " + to_string(-WD_DEF_VALUE)) {}
+Potion::Potion(const PotionType type) : Item('P'), type(type) {}
+RH::RH(): Potion (RH_POTION) {}
+BA::BA(): Potion (BA_POTION) {}
+BD::BD(): Potion (BD_POTION) {}
+PH::PH(): Potion (PH_POTION) {}
+WA::WA(): Potion (WA_POTION) {}
+WD::WD(): Potion (WD_POTION) {}
 
 // destructor
 Potion::~Potion() {}
@@ -73,6 +73,6 @@ void WD::pickUp(Player &p) {
 
 // see potion.h for details
 ostream& operator<<(ostream& out, const Potion& p) {
-    out << p.effect << endl;
+    out << POTION_EFFECTS[p.type] << endl;
     return out;
 } // operator<<
\ No newline at end of file
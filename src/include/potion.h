@@ -3,12 +3,15 @@
 
 #include <iostream>
 #include "item.h"
+#include "constants.h"
 
 class Potion : public Item {
   protected:
-    const std::string effect;
+    // type of the potion, whose effect is described in constants::POTION_EFFECTS
+    // (potions may not own anything outside their floor's arena)
+    const constants::PotionType type;
 
-    Potion(std::string effect);
+    Potion(const constants::PotionType type);
 
   public:
     /*******************************************************************************
@@ -6,6 +6,9 @@
 
 #include "potionDecorator.h"
 #include "constants.h"
+#include "pool.h"
+
+using namespace std;
 
 // constructors
 PotionDecorator::PotionDecorator(PotionDecorator *decorators, const float potionMultiplier): 
@@ -24,6 +27,16 @@ PotionDecorator::~PotionDecorator(){
     delete decorators;
 } // ~PotionDecorator()
 
+// see potionDecorator.h for details
+void* PotionDecorator::operator new(size_t size) {
+    return Pool::allocate(size);
+} // operator new
+
+// see potionDecorator.h for details
+void PotionDecorator::operator delete(void *p, size_t size) {
+    Pool::release(p, size);
+} // operator delete
+
 // see potionDecorator.h
 void PotionDecorator::getAtk(float& atk) const {
     if (decorators) decorators->getAtk(atk);
@@ -1,6 +1,8 @@
 #ifndef __POTION_DECORATOR_H__
 #define __POTION_DECORATOR_H__
 
+#include <cstddef>
+
 class PotionDecorator {
   protected:
     // linked list of decorators
@@ -32,6 +34,13 @@ class PotionDecorator {
     virtual void getDef(float& def) const;
 
     virtual ~PotionDecorator();
+
+    /*******************************************************************************
+     * operator new/delete take decorators from the object pool (see pool.h), 
+     *  since they are created and freed with every floor
+     * *****************************************************************************/
+    static void* operator new(std::size_t size);
+    static void operator delete(void *p, std::size_t size);
 };
 
 // types of PotionDecorator (temporary potions)
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * rng.cc
+ * 
+ * Module implementing the streams of random numbers used by the game.
+ * ****************************************************************************/
+
+#include "rng.h"
+
+namespace {
+    // every thread's own stream, and the stream it currently draws from
+    thread_local Rng ownStream;
+    thread_local Rng *currentStream = 0;
+} // namespace
+
+const int Rng::MAX;
+
+// constructor
+Rng::Rng(const unsigned int seed) : state(seed) {}
+
+// see rng.h for details
+void Rng::seed(const unsigned int s) {
+    state = s;
+} // seed()
+
+// see rng.h for details
+int Rng::next() {
+    state = state * 214013u + 2531011u;
+    return (state >> 16) & MAX;
+} // next()
+
+// see rng.h for details
+unsigned int Rng::substream(const unsigned int s, const unsigned int n) {
+    // mixes s and n so that nearby seeds give unrelated streams
+    unsigned int x = s ^ (n * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+} // substream()
+
+// see rng.h for details
+Rng& Rng::current() {
+    return currentStream ? *currentStream : ownStream;
+} // current()
+
+// see rng.h for details
+void Rng::use(Rng *r) {
+    currentStream = r;
+} // use()
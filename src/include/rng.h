@@ -0,0 +1,55 @@
+#ifndef __RNG_H__
+#define __RNG_H__
+
+class Rng {
+    // state of the sequence
+    unsigned int state;
+
+  public:
+    // largest number drawn
+    static const int MAX = 0x7FFF;
+
+    /*******************************************************************************
+     * Rng constructor creates a stream of random numbers determined by seed
+     * time: O(1)
+     * *****************************************************************************/
+    explicit Rng(const unsigned int seed = 1);
+
+    /*******************************************************************************
+     * seed(s) restarts the stream at the sequence determined by s
+     * time: O(1)
+     * *****************************************************************************/
+    void seed(const unsigned int s);
+
+    /*******************************************************************************
+     * next() draws the next number of the stream, in [0, MAX]
+     * notes: the sequence for a seed is the one of the rand() the game was 
+     *        originally written against, so recorded games replay on any platform
+     * time: O(1)
+     * *****************************************************************************/
+    int next();
+
+    /*******************************************************************************
+     * substream(s, n) gets the seed of the n-th substream of the stream determined
+     *  by s (independent of the numbers drawn from either)
+     * time: O(1)
+     * *****************************************************************************/
+    static unsigned int substream(const unsigned int s, const unsigned int n);
+
+    /*******************************************************************************
+     * current() gets the stream the calling thread draws from
+     * notes: each thread starts with its own stream, seeded with 1
+     * time: O(1)
+     * *****************************************************************************/
+    static Rng& current();
+
+    /*******************************************************************************
+     * use(r) makes the calling thread draw from r (or from its own stream if 
+     *  r is NULL)
+     * required: r outlives its use
+     * time: O(1)
+     * *****************************************************************************/
+    static void use(Rng *r);
+};
+
+#endif
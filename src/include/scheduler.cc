@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * scheduler.cc
+ * 
+ * Module implementing the timing wheel deciding when enemies act.
+ * ****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include "scheduler.h"
+#include "enemy.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+const int Scheduler::NUM_SLOTS;
+
+// constructor
+Scheduler::Scheduler() : now(0), position(0), nextOrder(0) {}
+
+// see scheduler.h for details
+void Scheduler::clear() {
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) slots[slot].clear();
+    now = 0;
+    position = 0;
+    nextOrder = 0;
+} // clear()
+
+// see scheduler.h for details
+int Scheduler::interval(const Enemy &e) {
+    const int speed = e.getSpeed();
+    assert(1 <= speed && speed <= MAX_SPEED);
+    return TICKS_PER_TURN * NORMAL_SPEED / speed;
+} // interval()
+
+// see scheduler.h for details
+bool Scheduler::actsBefore(const Enemy *e, const int order) {
+    return e->actOrder < order;
+} // actsBefore()
+
+// see scheduler.h for details
+void Scheduler::insert(Enemy &e) {
+    assert(now < e.actTime && e.actTime - now < NUM_SLOTS);
+    vector<Enemy *> &slot = slots[e.actTime % NUM_SLOTS];
+    if (slot.empty() || slot.back()->actOrder < e.actOrder) slot.push_back(&e);
+    else slot.insert(lower_bound(slot.begin(), slot.end(), e.actOrder, actsBefore), &e);
+} // insert()
+
+// see scheduler.h for details
+size_t Scheduler::find(const Enemy &e) const {
+    const vector<Enemy *> &slot = slots[e.actTime % NUM_SLOTS];
+
+    // the enemies before position have acted already, and are in later slots
+    const size_t first = (e.actTime == now) ? position : 0;
+    const size_t i = lower_bound(slot.begin() + first, slot.end(), e.actOrder, actsBefore) - slot.begin();
+    assert(i < slot.size() && slot[i] == &e);
+    return i;
+} // find()
+
+// see scheduler.h for details
+void Scheduler::add(Enemy &e) {
+    e.actOrder = nextOrder++;
+    e.actTime = now + interval(e);
+    e.parked = false;
+    insert(e);
+} // add()
+
+// see scheduler.h for details
+void Scheduler::remove(const Enemy &e) {
+    if (e.parked) return;
+    vector<Enemy *> &slot = slots[e.actTime % NUM_SLOTS];
+    const size_t i = find(e);
+    slot.erase(slot.begin() + i);
+} // remove()
+
+// see scheduler.h for details
+void Scheduler::park(Enemy &e) {
+    assert(!e.parked);
+    remove(e);
+    e.parked = true;
+} // park()
+
+// see scheduler.h for details
+int Scheduler::wake(Enemy &e) {
+    if (!e.parked) return 0;
+    e.parked = false;
+    const int step = interval(e);
+    const int missed = (e.actTime <= now) ? (now - e.actTime) / step + 1 : 0;
+    e.actTime += missed * step;
+    insert(e);
+    return missed;
+} // wake()
+
+// see scheduler.h for details
+bool Scheduler::isParked(const Enemy &e) const {
+    return e.parked;
+} // isParked()
+
+// see scheduler.h for details
+Enemy* Scheduler::next(const int until) {
+    assert(now <= until);
+    while (true) {
+        vector<Enemy *> &slot = slots[now % NUM_SLOTS];
+        if (position < slot.size()) {
+            Enemy *e = slot[position++];
+            e->actTime = now + interval(*e);
+            insert(*e);
+            return e;
+        } // if
+
+        // every enemy acting now has acted
+        slot.clear();
+        position = 0;
+        if (now == until) return NULL;
+        ++now;
+    } // while
+} // next()
+
+// see scheduler.h for details
+int Scheduler::getTime() const {
+    return now;
+} // getTime()
@@ -0,0 +1,112 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <cstddef>
+#include <vector>
+
+class Enemy;
+
+class Scheduler {
+    // number of slots of the wheel; every interval between two actions of an
+    // enemy is shorter, so each slot only holds enemies acting at one time
+    static const int NUM_SLOTS = 256;
+
+    // enemies acting at every time t (in slot t % NUM_SLOTS), in the order 
+    // they were added to the scheduler
+    std::vector<Enemy *> slots[NUM_SLOTS];
+
+    // current time, in ticks
+    int now;
+
+    // position in the slot of the current time of the next enemy to act
+    std::size_t position;
+
+    // order given to the next enemy added
+    int nextOrder;
+
+    /*******************************************************************************
+     * insert(e) puts e in the slot of its next action
+     * time: O(log #enemies) to find its place, O(1) when it acts after the 
+     *       others in the slot
+     * *****************************************************************************/
+    void insert(Enemy &e);
+
+    // position of e in the slot of its next action (e must be in it)
+    std::size_t find(const Enemy &e) const;
+
+    // determines if e acts before the enemy of the given order, when both act
+    // at the same time
+    static bool actsBefore(const Enemy *e, const int order);
+
+  public:
+    /*******************************************************************************
+     * Scheduler constructor creates an empty scheduler at time 0
+     * time: O(NUM_SLOTS)
+     * *****************************************************************************/
+    Scheduler();
+
+    /*******************************************************************************
+     * clear() forgets every enemy and turns the time back to 0
+     * notes: keeps the storage of the slots
+     * time: O(NUM_SLOTS)
+     * *****************************************************************************/
+    void clear();
+
+    /*******************************************************************************
+     * interval(e) gets the number of ticks between two actions of e
+     * time: O(1)
+     * *****************************************************************************/
+    static int interval(const Enemy &e);
+
+    /*******************************************************************************
+     * add(e) schedules e to act every interval(e) ticks, starting interval(e)
+     *  ticks from now
+     * notes: enemies acting at the same time act in the order they were added
+     * required: e has not been added yet
+     * time: O(1)
+     * *****************************************************************************/
+    void add(Enemy &e);
+
+    /*******************************************************************************
+     * remove(e) forgets e (which may be parked)
+     * time: O(#enemies acting when e next acts)
+     * *****************************************************************************/
+    void remove(const Enemy &e);
+
+    /*******************************************************************************
+     * park(e) stops e from acting (and from being looked at) until woken
+     * required: e is scheduled, and is not parked
+     * time: O(#enemies acting when e next acts)
+     * *****************************************************************************/
+    void park(Enemy &e);
+
+    /*******************************************************************************
+     * wake(e) has a parked enemy e act again, at the next of the times it would 
+     *  have acted at had it not been parked, and gets the number of those times
+     *  that have passed while it was parked
+     * notes: does nothing (and gets 0) if e is not parked
+     *        an enemy parked by the caller instead of acting (see next()) also 
+     *        missed that action, which is not counted
+     * time: O(log #enemies)
+     * *****************************************************************************/
+    int wake(Enemy &e);
+
+    // determines if e is parked
+    bool isParked(const Enemy &e) const;
+
+    /*******************************************************************************
+     * next(until) advances the time to the next action of an enemy, up to until,
+     *  and gets that enemy (or NULL, with the time at until, if no enemy acts
+     *  before then)
+     * notes: the enemy is scheduled for its following action before it is
+     *        returned
+     * required: until >= the current time
+     * time: O(1) amortized per tick and per action
+     * *****************************************************************************/
+    Enemy* next(const int until);
+
+    // getter for the current time
+    int getTime() const;
+};
+
+#endif
@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * trace.cc
+ *
+ * Module implementing the recording of Chrome trace events.
+ * ****************************************************************************/
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "trace.h"
+
+using namespace std;
+
+namespace {
+    // spans recorded before the writer is woken up
+    const size_t BATCH = 4096;
+
+    // longest the writer sleeps with spans pending
+    const chrono::milliseconds WRITE_INTERVAL(100);
+
+    // appends the decimal digits of n to p, moving p past them
+    void appendNumber(char *&p, int64_t n) {
+        char digits[20];
+        int numDigits = 0;
+        do {
+            digits[numDigits++] = '0' + n % 10;
+            n /= 10;
+        } while (n > 0);
+        while (numDigits > 0) *p++ = digits[--numDigits];
+    } // appendNumber()
+
+    // appends s to p, moving p past it
+    void appendString(char *&p, const char *s) {
+        const size_t length = strlen(s);
+        memcpy(p, s, length);
+        p += length;
+    } // appendString()
+
+    // appends ns nanoseconds as microseconds (to the nanosecond) to p, moving
+    // p past them
+    void appendMicros(char *&p, const int64_t ns) {
+        appendNumber(p, ns / 1000);
+        const int fraction = ns % 1000;
+        *p++ = '.';
+        *p++ = '0' + fraction / 100;
+        *p++ = '0' + fraction / 10 % 10;
+        *p++ = '0' + fraction % 10;
+    } // appendMicros()
+
+    // longest name of a span, and longest line of the trace
+    const size_t MAX_NAME = 64;
+    const size_t MAX_LINE = MAX_NAME + 192;
+
+    // a span, as recorded
+    struct Event {
+        const char *name;
+        int floorNum;
+        int session;
+        int thread;
+        // nanoseconds since the trace started
+        int64_t start;
+        int64_t duration;
+    };
+
+    // writes the spans to the trace file on a thread of its own
+    class Writer {
+        ofstream out;
+        const chrono::steady_clock::time_point origin;
+
+        // text of the batch being written
+        string text;
+
+        // spans not written yet, guarded by lock; the writer waits on ready
+        mutex lock;
+        condition_variable ready;
+        vector<Event> pending;
+        bool stopping;
+
+        thread worker;
+
+        // writes events to the file (formatted by hand, which is several times
+        // faster than through printf or streams)
+        void write(const vector<Event> &events) {
+            text.resize(events.size() * MAX_LINE);
+            char *p = &text[0];
+            for (vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+                // (timestamps in microseconds, to the nanosecond)
+                appendString(p, ",\n{\"name\":\"");
+                appendString(p, it->name);
+                appendString(p, "\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":");
+                appendMicros(p, it->start);
+                appendString(p, ",\"dur\":");
+                appendMicros(p, it->duration);
+                appendString(p, ",\"pid\":1,\"tid\":");
+                appendNumber(p, it->thread);
+                appendString(p, ",\"args\":{\"floor\":");
+                appendNumber(p, it->floorNum);
+                appendString(p, ",\"session\":");
+                appendNumber(p, it->session);
+                appendString(p, "}}");
+            } // for
+            out.write(text.data(), p - text.data());
+        } // write()
+
+        // body of the worker: writes the pending spans in batches until stopping
+        void work() {
+            vector<Event> batch;
+            unique_lock<mutex> guard(lock);
+            while (true) {
+                ready.wait_for(guard, WRITE_INTERVAL, [this]() { return stopping || pending.size() >= BATCH; });
+                batch.swap(pending);
+                const bool done = stopping;
+                guard.unlock();
+                write(batch);
+                batch.clear();
+                if (done) return;
+                guard.lock();
+            } // while
+        } // work()
+
+      public:
+        Writer(const string &filename) : out(filename.c_str()), origin(chrono::steady_clock::now()),
+                                          stopping(false) {
+            if (!out.good()) return;
+            // (the metadata event starts the array, so every span is preceded by a comma)
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"dungeoncrusader\"}}";
+            pending.reserve(BATCH);
+            worker = thread(&Writer::work, this);
+        } // Writer ctor
+
+        // writes what is pending and closes the file
+        ~Writer() {
+            if (!worker.joinable()) return;
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            ready.notify_one();
+            worker.join();
+            out << "\n]}\n";
+        } // ~Writer()
+
+        bool isOpen() const {
+            return worker.joinable();
+        } // isOpen()
+
+        void add(const char *name, const int floorNum, const int session, const int thread,
+                 const chrono::steady_clock::time_point start, const chrono::steady_clock::time_point end) {
+            assert(strlen(name) <= MAX_NAME);
+            Event e;
+            e.name = name;
+            e.floorNum = floorNum;
+            e.session = session;
+            e.thread = thread;
+            e.start = chrono::duration_cast<chrono::nanoseconds>(start - origin).count();
+            e.duration = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+            bool full;
+            {
+                lock_guard<mutex> guard(lock);
+                pending.push_back(e);
+                full = pending.size() == BATCH;
+            }
+            if (full) ready.notify_one();
+        } // add()
+    };
+
+    // writer of the trace being recorded (NULL if none)
+    Writer *writer = NULL;
+
+    // sessions started so far
+    atomic<int> numSessions(0);
+
+    // threads that recorded spans so far, and the number of the calling one (0
+    // until it records one)
+    atomic<int> numThreads(0);
+    thread_local int threadNum = 0;
+
+    // session of the calling thread (0 if none)
+    thread_local int currentSession = 0;
+} // namespace
+
+atomic<bool> Trace::recording(false);
+
+// see trace.h for details
+bool Trace::start(const string &filename) {
+    writer = new Writer(filename);
+    if (!writer->isOpen()) {
+        delete writer;
+        writer = NULL;
+        return false;
+    } // if
+    recording = true;
+    return true;
+} // start()
+
+// see trace.h for details
+void Trace::stop() {
+    recording = false;
+    delete writer;
+    writer = NULL;
+} // stop()
+
+// see trace.h for details
+bool Trace::isRecording() {
+    return recording.load(memory_order_relaxed);
+} // isRecording()
+
+// see trace.h for details
+void Trace::record(const char *name, const int floorNum, const int session,
+                   const chrono::steady_clock::time_point start, const chrono::steady_clock::time_point end) {
+    if (!isRecording()) return;
+    if (!threadNum) threadNum = ++numThreads;
+    writer->add(name, floorNum, session, threadNum, start, end);
+} // record()
+
+// see trace.h for details
+int Trace::newSession() {
+    currentSession = ++numSessions;
+    return currentSession;
+} // newSession()
+
+// see trace.h for details
+int Trace::session() {
+    return currentSession;
+} // session()
+
+// see trace.h for details
+void Trace::useSession(const int s) {
+    currentSession = s;
+} // useSession()
+
+// constructor
+TraceSpan::TraceSpan(const char *name, const int floorNum, const int session) :
+        name(name), floorNum(floorNum), session(session), on(Trace::isRecording()) {
+    if (on) start = chrono::steady_clock::now();
+} // TraceSpan ctor
+
+// destructor
+TraceSpan::~TraceSpan() {
+    if (on) Trace::record(name, floorNum, session, start, chrono::steady_clock::now());
+} // ~TraceSpan()
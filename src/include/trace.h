@@ -0,0 +1,81 @@
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <string>
+#include <chrono>
+#include <atomic>
+
+/*******************************************************************************
+ * Trace records spans of the game (floor construction and population, turns,
+ * enemies' actions, rendering) as Chrome trace events, in the JSON format that
+ * chrome://tracing and Perfetto load; every span is tagged with its floor
+ * number and its session (the games played by one call to playGames())
+ * notes: the events are written to the file by a background thread, in
+ *        batches, so that recording a span costs little more than reading the
+ *        clock twice; when no trace is recorded, a span costs a flag check
+ * *****************************************************************************/
+class Trace {
+    // is a trace being recorded?
+    static std::atomic<bool> recording;
+
+  public:
+    /*******************************************************************************
+     * start(filename) starts recording a trace into filename (replacing it)
+     * notes: returns false if filename cannot be written
+     * required: no trace is being recorded
+     * time: O(1)
+     * *****************************************************************************/
+    static bool start(const std::string &filename);
+
+    /*******************************************************************************
+     * stop() writes the spans recorded so far and closes the trace, if one is
+     *  being recorded
+     * required: no span is being recorded on any thread
+     * time: O(#spans not written yet)
+     * *****************************************************************************/
+    static void stop();
+
+    // is a trace being recorded?
+    static bool isRecording();
+
+    /*******************************************************************************
+     * record(name, floorNum, session, start, end) records a span from start to
+     *  end on the calling thread
+     * required: name is a string literal of at most 64 characters (written as is)
+     * notes: does nothing unless a trace is being recorded
+     * time: O(1) amortized
+     * *****************************************************************************/
+    static void record(const char *name, const int floorNum, const int session,
+                       const std::chrono::steady_clock::time_point start,
+                       const std::chrono::steady_clock::time_point end);
+
+    /*******************************************************************************
+     * newSession() starts a new session on the calling thread, and returns its id
+     * session() gets the session of the calling thread (0 if none)
+     * useSession(s) makes s the session of the calling thread (e.g. a thread
+     *  working for another one)
+     * time: O(1)
+     * *****************************************************************************/
+    static int newSession();
+    static int session();
+    static void useSession(const int s);
+};
+
+/*******************************************************************************
+ * TraceSpan records a span from its construction to its destruction (if a
+ * trace is being recorded)
+ * required: name is a string literal
+ * *****************************************************************************/
+class TraceSpan {
+    const char *name;
+    const int floorNum;
+    const int session;
+    const bool on;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    TraceSpan(const char *name, const int floorNum, const int session);
+    ~TraceSpan();
+};
+
+#endif
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * turnStats.cc
+ *
+ * Module implementing the timing of the phases of the turns.
+ * ****************************************************************************/
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <iomanip>
+#include <algorithm>
+#include "turnStats.h"
+
+using namespace std;
+
+namespace {
+    // names of the phases, in the order of TurnStats::Phase
+    const char *PHASE_NAMES[TurnStats::NUM_PHASES] =
+        {"input", "pc action", "enemies", "turn end", "render"};
+
+    // percentiles printed for every phase
+    const int NUM_PERCENTILES = 4;
+    const double PERCENTILES[NUM_PERCENTILES] = {50, 90, 99, 99.9};
+    const char *PERCENTILE_NAMES[NUM_PERCENTILES] = {"p50", "p90", "p99", "p99.9"};
+
+    // statistics the calling thread records into (NULL if none), and the phase
+    // it is in (NUM_PHASES if none)
+    thread_local TurnStats *currentStats = 0;
+    thread_local int currentPhase = TurnStats::NUM_PHASES;
+
+    // orders phases by the allocations, then the game exceptions, they made
+    class MoreAllocations {
+        const TurnStats &stats;
+      public:
+        explicit MoreAllocations(const TurnStats &stats) : stats(stats) {}
+        bool operator()(const int a, const int b) const {
+            const TurnStats::Counts &countsA = stats.getCounts((TurnStats::Phase) a);
+            const TurnStats::Counts &countsB = stats.getCounts((TurnStats::Phase) b);
+            if (countsA.allocations != countsB.allocations) return countsA.allocations > countsB.allocations;
+            return countsA.throws > countsB.throws;
+        } // operator()
+    };
+
+    // position of the highest set bit of w
+    // required: w != 0
+    int highestBit(uint64_t w) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(w);
+#else
+        int bit = 0;
+        for (; w >>= 1; ) ++bit;
+        return bit;
+#endif
+    } // highestBit()
+} // namespace
+
+#ifndef TURN_STATS
+const bool TurnStats::ENABLED = false;
+#else
+const bool TurnStats::ENABLED = true;
+
+// counts every allocation (the matching operator delete frees what it allocates)
+void* operator new(size_t size) {
+    TurnStats::countAllocation(size);
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+} // operator new()
+
+void operator delete(void *p) noexcept {
+    free(p);
+} // operator delete()
+#endif
+
+// constructor
+TurnStats::Counts::Counts() : allocations(0), bytes(0), throws(0) {}
+
+// constructor
+Histogram::Histogram() : count(0), min(0), max(0), sum(0) {
+    for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket) counts[bucket] = 0;
+} // Histogram ctor
+
+// see turnStats.h for details
+int Histogram::bucketOf(const uint64_t value) {
+    if (value < 2 * SUB_BUCKETS) return value;
+    // the top SUB_BITS + 1 bits of value pick the bucket among those of its power of two
+    const int shift = highestBit(value) - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + (value >> shift) - SUB_BUCKETS;
+} // bucketOf()
+
+// see turnStats.h for details
+uint64_t Histogram::highestIn(const int bucket) {
+    if (bucket < 2 * SUB_BUCKETS) return bucket;
+    const int shift = bucket / SUB_BUCKETS - 1;
+    const uint64_t top = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    // (wraps around to the largest value for the last bucket)
+    return ((top + 1) << shift) - 1;
+} // highestIn()
+
+// see turnStats.h for details
+void Histogram::record(const uint64_t value) {
+    ++counts[bucketOf(value)];
+    if (count == 0 || value < min) min = value;
+    if (value > max) max = value;
+    ++count;
+    sum += value;
+} // record()
+
+// see turnStats.h for details
+uint64_t Histogram::getCount() const {
+    return count;
+} // getCount()
+
+// see turnStats.h for details
+uint64_t Histogram::getMin() const {
+    return min;
+} // getMin()
+
+// see turnStats.h for details
+uint64_t Histogram::getMax() const {
+    return max;
+} // getMax()
+
+// see turnStats.h for details
+uint64_t Histogram::getMean() const {
+    return count ? sum / count : 0;
+} // getMean()
+
+// see turnStats.h for details
+uint64_t Histogram::valueAtPercentile(const double p) const {
+    assert(0 <= p && p <= 100);
+    if (count == 0) return 0;
+    // rank (from 1) of the value sought
+    uint64_t rank = (uint64_t) (p / 100 * count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) return highestIn(bucket) < max ? highestIn(bucket) : max;
+    } // for
+    return max;
+} // valueAtPercentile()
+
+// see turnStats.h for details
+void TurnStats::record(const Phase phase, const uint64_t ns) {
+    assert(0 <= phase && phase < NUM_PHASES);
+    histograms[phase].record(ns);
+} // record()
+
+// see turnStats.h for details
+const Histogram& TurnStats::getHistogram(const Phase phase) const {
+    assert(0 <= phase && phase < NUM_PHASES);
+    return histograms[phase];
+} // getHistogram()
+
+// see turnStats.h for details
+const TurnStats::Counts& TurnStats::getCounts(const Phase phase) const {
+    assert(0 <= phase && phase <= NUM_PHASES);
+    return phaseCounts[phase];
+} // getCounts()
+
+// see turnStats.h for details
+const Histogram& TurnStats::getTurnAllocations() const {
+    return turnAllocations;
+} // getTurnAllocations()
+
+// see turnStats.h for details
+const Histogram& TurnStats::getTurnThrows() const {
+    return turnThrows;
+} // getTurnThrows()
+
+// see turnStats.h for details
+void TurnStats::print(ostream &out) const {
+    out << "Turn phase times (ns):" << endl << left << setw(10) << "phase" << right << setw(10) << "count"
+        << setw(12) << "min";
+    for (int i = 0; i < NUM_PERCENTILES; ++i) out << setw(12) << PERCENTILE_NAMES[i];
+    out << setw(12) << "max" << setw(12) << "mean" << endl;
+
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        const Histogram &h = histograms[phase];
+        out << left << setw(10) << PHASE_NAMES[phase] << right << setw(10) << h.getCount()
+            << setw(12) << h.getMin();
+        for (int i = 0; i < NUM_PERCENTILES; ++i) out << setw(12) << h.valueAtPercentile(PERCENTILES[i]);
+        out << setw(12) << h.getMax() << setw(12) << h.getMean() << endl;
+    } // for
+
+    // the phases (and what happened between them) that allocated the most
+    int phases[NUM_PHASES + 1];
+    for (int phase = 0; phase <= NUM_PHASES; ++phase) phases[phase] = phase;
+    sort(phases, phases + NUM_PHASES + 1, MoreAllocations(*this));
+    out << "Allocations and game exceptions by phase (most first):" << endl << left << setw(10) << "phase" 
+        << right << setw(14) << "allocations" << setw(14) << "bytes" << setw(14) << "exceptions" << endl;
+    for (int i = 0; i <= NUM_PHASES; ++i) {
+        const Counts &counts = phaseCounts[phases[i]];
+        out << left << setw(10) << (phases[i] == NUM_PHASES ? "other" : PHASE_NAMES[phases[i]]) << right 
+            << setw(14) << counts.allocations << setw(14) << counts.bytes << setw(14) << counts.throws << endl;
+    } // for
+
+    // what a turn did
+    const Histogram *perTurn[2] = {&turnAllocations, &turnThrows};
+    const char *perTurnNames[2] = {"allocs", "exceptions"};
+    out << "Per turn:" << endl << left << setw(10) << "" << right << setw(10) << "turns" << setw(12) << "min";
+    for (int i = 0; i < NUM_PERCENTILES; ++i) out << setw(12) << PERCENTILE_NAMES[i];
+    out << setw(12) << "max" << setw(12) << "mean" << endl;
+    for (int j = 0; j < 2; ++j) {
+        const Histogram &h = *perTurn[j];
+        out << left << setw(10) << perTurnNames[j] << right << setw(10) << h.getCount() << setw(12) << h.getMin();
+        for (int i = 0; i < NUM_PERCENTILES; ++i) out << setw(12) << h.valueAtPercentile(PERCENTILES[i]);
+        out << setw(12) << h.getMax() << setw(12) << h.getMean() << endl;
+    } // for
+} // print()
+
+// see turnStats.h for details
+TurnStats* TurnStats::current() {
+    return currentStats;
+} // current()
+
+// see turnStats.h for details
+void TurnStats::use(TurnStats *s) {
+    currentStats = s;
+} // use()
+
+// see turnStats.h for details
+void TurnStats::startTurn() {
+    if (currentStats) currentStats->turn = Counts();
+} // startTurn()
+
+// see turnStats.h for details
+void TurnStats::endTurn() {
+    if (!currentStats) return;
+    currentStats->turnAllocations.record(currentStats->turn.allocations);
+    currentStats->turnThrows.record(currentStats->turn.throws);
+} // endTurn()
+
+// see turnStats.h for details
+void TurnStats::countAllocation(const size_t bytes) {
+    if (!currentStats) return;
+    Counts &counts = currentStats->phaseCounts[currentPhase];
+    ++counts.allocations;
+    counts.bytes += bytes;
+    ++currentStats->turn.allocations;
+    currentStats->turn.bytes += bytes;
+} // countAllocation()
+
+// see turnStats.h for details
+void TurnStats::countThrow() {
+    if (!currentStats) return;
+    ++currentStats->phaseCounts[currentPhase].throws;
+    ++currentStats->turn.throws;
+} // countThrow()
+
+// constructor
+PhaseTimer::PhaseTimer(const TurnStats::Phase phase) : stats(TurnStats::current()), phase(phase), 
+                                                        outerPhase(currentPhase) {
+    if (!stats) return;
+    currentPhase = phase;
+    start = chrono::steady_clock::now();
+} // PhaseTimer ctor
+
+// destructor
+PhaseTimer::~PhaseTimer() {
+    if (!stats) return;
+    const chrono::nanoseconds elapsed = chrono::steady_clock::now() - start;
+    stats->record(phase, elapsed.count());
+    currentPhase = outerPhase;
+} // ~PhaseTimer()
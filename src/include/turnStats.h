@@ -0,0 +1,196 @@
+#ifndef __TURNSTATS_H__
+#define __TURNSTATS_H__
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/*******************************************************************************
+ * Histogram counts durations (in nanoseconds) in log-linear buckets, as HDR
+ * histograms do: every power of two is split into SUB_BUCKETS buckets, so any
+ * value is reported within 1/SUB_BUCKETS of its true value, whatever its size
+ * *****************************************************************************/
+class Histogram {
+  public:
+    // buckets per power of two
+    static const int SUB_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+
+    // number of buckets needed to count any 64-bit value (values below
+    // 2 * SUB_BUCKETS have a bucket each)
+    static const int NUM_BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+  private:
+    uint64_t counts[NUM_BUCKETS];
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+
+    // bucket counting value
+    static int bucketOf(const uint64_t value);
+
+    // largest value counted in bucket
+    static uint64_t highestIn(const int bucket);
+
+  public:
+    // creates an empty histogram
+    Histogram();
+
+    /*******************************************************************************
+     * record(value) counts value
+     * time: O(1)
+     * *****************************************************************************/
+    void record(const uint64_t value);
+
+    // getter for the number of values recorded
+    uint64_t getCount() const;
+
+    // getters for the smallest, largest and mean value recorded (0 if none)
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    uint64_t getMean() const;
+
+    /*******************************************************************************
+     * valueAtPercentile(p) gets the value that p percent of the values recorded
+     *  are at most (within the precision of the buckets)
+     * required: 0 <= p <= 100
+     * notes: 0 if no value was recorded
+     * time: O(NUM_BUCKETS)
+     * *****************************************************************************/
+    uint64_t valueAtPercentile(const double p) const;
+};
+
+/*******************************************************************************
+ * TurnStats holds how long each phase of the turns of a session took (a
+ * session being the games played by one call to playGames()), and how many 
+ * heap allocations (and bytes) and game exceptions each phase and each turn 
+ * made
+ * notes: the phases are timed by TIME_PHASE, and game exceptions counted by 
+ *        COUNT_THROW, which compile to nothing unless TURN_STATS is defined (as
+ *        does the counting of allocations, done by replacing operator new), 
+ *        so only the builds that report them pay for them (see Makefile)
+ *        only what the thread playing the session does is counted (not what 
+ *        the chamber workers or the floor builder do)
+ * *****************************************************************************/
+class TurnStats {
+  public:
+    enum Phase {Input, PCAction, Enemies, TurnFinished, Render, NUM_PHASES};
+
+    // false if the phases are not timed in this build (see TURN_STATS)
+    static const bool ENABLED;
+
+    // what a phase or a turn did
+    struct Counts {
+        uint64_t allocations;
+        uint64_t bytes;
+        uint64_t throws;
+
+        Counts();
+    };
+
+  private:
+    Histogram histograms[NUM_PHASES];
+
+    // what every phase did, and what was done outside of them (last)
+    Counts phaseCounts[NUM_PHASES + 1];
+
+    // what the current turn did so far
+    Counts turn;
+
+    // what the turns did
+    Histogram turnAllocations;
+    Histogram turnThrows;
+
+  public:
+    /*******************************************************************************
+     * record(phase, ns) counts a phase that took ns nanoseconds
+     * time: O(1)
+     * *****************************************************************************/
+    void record(const Phase phase, const uint64_t ns);
+
+    // getter for the histogram of phase
+    const Histogram& getHistogram(const Phase phase) const;
+
+    // getter for what phase did
+    const Counts& getCounts(const Phase phase) const;
+
+    // getters for the histograms of the allocations and game exceptions of 
+    // every turn (see startTurn())
+    const Histogram& getTurnAllocations() const;
+    const Histogram& getTurnThrows() const;
+
+    /*******************************************************************************
+     * print(out) prints a table of the count, percentiles and extremes of the
+     *  times of every phase, then the phases that allocated and threw the most
+     *  and the percentiles of the allocations and game exceptions of a turn
+     * time: O(NUM_PHASES * Histogram::NUM_BUCKETS)
+     * *****************************************************************************/
+    void print(std::ostream &out) const;
+
+    /*******************************************************************************
+     * startTurn() starts counting a turn of the calling thread's statistics
+     *  (if any) afresh, forgetting what was counted since the last turn ended
+     * endTurn() records what was counted since into the turn histograms
+     * notes: a turn runs from the prompt for a command until the floor is 
+     *        printed after it, or until the PC's action turns out to be 
+     *        invalid (which is recorded too); commands that are not actions
+     *        (e.g. h, or an unknown one) are not turns
+     * time: O(1)
+     * *****************************************************************************/
+    static void startTurn();
+    static void endTurn();
+
+    /*******************************************************************************
+     * countAllocation(bytes) counts an allocation of bytes, and countThrow() a 
+     *  game exception, into the calling thread's statistics (if any)
+     * time: O(1)
+     * *****************************************************************************/
+    static void countAllocation(const std::size_t bytes);
+    static void countThrow();
+
+    /*******************************************************************************
+     * current() gets the statistics the calling thread records into
+     * notes: NULL unless statistics are kept (see use())
+     * time: O(1)
+     * *****************************************************************************/
+    static TurnStats* current();
+
+    /*******************************************************************************
+     * use(s) makes the calling thread record into s (or stop recording if s is
+     *  NULL)
+     * required: s outlives its use
+     * time: O(1)
+     * *****************************************************************************/
+    static void use(TurnStats *s);
+};
+
+/*******************************************************************************
+ * PhaseTimer times a phase from its construction to its destruction, recording
+ * it into the calling thread's statistics (if any)
+ * *****************************************************************************/
+class PhaseTimer {
+    TurnStats *stats;
+    const TurnStats::Phase phase;
+    std::chrono::steady_clock::time_point start;
+
+    // phase the thread was in before (phases may nest)
+    int outerPhase;
+
+  public:
+    explicit PhaseTimer(const TurnStats::Phase phase);
+    ~PhaseTimer();
+};
+
+// times the rest of the enclosing block as phase (one of TurnStats::Phase), 
+// and counts a game exception
+#ifdef TURN_STATS
+#define TIME_PHASE(phase) PhaseTimer phaseTimer(TurnStats::phase)
+#define COUNT_THROW() TurnStats::countThrow()
+#else
+#define TIME_PHASE(phase)
+#define COUNT_THROW()
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * workerPool.cc
+ * 
+ * Module implementing a pool of threads running batches of tasks.
+ * ****************************************************************************/
+
+#include <cassert>
+#include "workerPool.h"
+
+using namespace std;
+
+// constructor
+WorkerPool::WorkerPool(const int numWorkers) : task(NULL), numTasks(0), nextTask(0), 
+        numBusy(0), batch(0), stopping(false) {
+    for (int i = 0; i < numWorkers; ++i) workers.push_back(thread(&WorkerPool::work, this));
+} // WorkerPool ctor
+
+// destructor
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        assert(!task);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (vector<thread>::iterator it = workers.begin(); it != workers.end(); ++it) it->join();
+} // WorkerPool dtor
+
+// see workerPool.h for details
+void WorkerPool::runTasks(unique_lock<mutex> &guard) {
+    while (nextTask < numTasks) {
+        const int i = nextTask++;
+        guard.unlock();
+        exception_ptr error;
+        try {
+            (*task)(i);
+        } catch (...) {
+            error = current_exception();
+        } // catch
+        guard.lock();
+        if (error && !failure) failure = error;
+    } // while
+} // runTasks()
+
+// see workerPool.h for details
+void WorkerPool::work() {
+    unique_lock<mutex> guard(lock);
+    unsigned int joined = batch;
+    while (true) {
+        while (!stopping && (!task || joined == batch)) changed.wait(guard);
+        if (stopping) return;
+        joined = batch;
+        ++numBusy;
+        runTasks(guard);
+        if (--numBusy == 0) finished.notify_all();
+    } // while
+} // work()
+
+// see workerPool.h for details
+void WorkerPool::run(const int numTasks, const function<void(int)> &task) {
+    // (waits for the batch of another caller, if any, to end)
+    unique_lock<mutex> guard(lock);
+    while (this->task) finished.wait(guard);
+    this->task = &task;
+    this->numTasks = numTasks;
+    nextTask = 0;
+    ++batch;
+    failure = exception_ptr();
+    if (!workers.empty() && numTasks > 1) changed.notify_all();
+
+    // helps with the tasks, then waits for the workers still running some
+    runTasks(guard);
+    while (numBusy) finished.wait(guard);
+    this->task = NULL;
+    exception_ptr error = failure;
+    failure = exception_ptr();
+    finished.notify_all();
+    if (error) rethrow_exception(error);
+} // run()
+
+// see workerPool.h for details
+int WorkerPool::getNumWorkers() const {
+    return workers.size();
+} // getNumWorkers()
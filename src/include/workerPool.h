@@ -0,0 +1,84 @@
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+
+class WorkerPool {
+    // threads helping the caller of run()
+    std::vector<std::thread> workers;
+
+    // guards the state below; the workers wait on changed, and run() waits on
+    // finished for the workers to be done with the current batch (or for the
+    // batch of another caller to end)
+    std::mutex lock;
+    std::condition_variable changed;
+    std::condition_variable finished;
+
+    // batch of tasks being run (NULL if none): task(i) for 0 <= i < numTasks
+    const std::function<void(int)> *task;
+    int numTasks;
+
+    // next task to be started, and number of workers in the current batch
+    int nextTask;
+    int numBusy;
+
+    // incremented for every batch, so that each worker joins every batch once
+    unsigned int batch;
+
+    // first exception thrown by a task of the current batch
+    std::exception_ptr failure;
+
+    // set when the workers are to exit
+    bool stopping;
+
+    /*******************************************************************************
+     * runTasks(guard) runs tasks of the current batch until none is left
+     * required: guard holds lock (it is released while a task runs)
+     * time: O(total time of the tasks run)
+     * *****************************************************************************/
+    void runTasks(std::unique_lock<std::mutex> &guard);
+
+    // body of the workers: joins every batch until stopping
+    void work();
+
+    // pools cannot be copied
+    WorkerPool(const WorkerPool &other);
+    WorkerPool& operator= (const WorkerPool &other);
+
+  public:
+    /*******************************************************************************
+     * WorkerPool constructor starts numWorkers threads (none if numWorkers <= 0)
+     * time: O(numWorkers)
+     * *****************************************************************************/
+    explicit WorkerPool(const int numWorkers);
+
+    /*******************************************************************************
+     * WorkerPool destructor stops the workers
+     * required: no batch is being run
+     * time: O(#workers)
+     * *****************************************************************************/
+    ~WorkerPool();
+
+    /*******************************************************************************
+     * run(numTasks, task) runs task(i) for every 0 <= i < numTasks, on the 
+     *  calling thread and the workers, and returns once they are all done
+     * notes: tasks are started in order, but may run in any order and at the 
+     *        same time
+     *        runs one batch at a time: callers on other threads wait for 
+     *        the batch being run to end
+     * exceptions: rethrows the first exception thrown by a task (every task is
+     *             still run)
+     * time: O(total time of the tasks / #threads) if they are balanced
+     * *****************************************************************************/
+    void run(const int numTasks, const std::function<void(int)> &task);
+
+    // gets the number of workers
+    int getNumWorkers() const;
+};
+
+#endif
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * budgetTest.cc
+ *
+ * Checks that the turns of a game stay within a budget of heap allocations and
+ * game exceptions: plays scripted sessions on every configuration given, once
+ * to warm up whatever the game caches and once counting (see TurnStats), and
+ * fails if any turn of the counted sessions allocated or threw more than the
+ * budget allows.
+ *
+ * Usage: ./budgetTest maxAllocations maxExceptions config ...
+ *        (from the root of the repository)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include "game.h"
+#include "console.h"
+#include "turnStats.h"
+#include "rng.h"
+
+using namespace std;
+
+namespace {
+    // sessions played on every configuration, and commands in each
+    const int NUM_SEEDS = 3;
+    const int NUM_COMMANDS = 600;
+
+    // commands the script picks from (moves and attacks in every direction)
+    const int NUM_SCRIPT_COMMANDS = 16;
+    const char *SCRIPT_COMMANDS[NUM_SCRIPT_COMMANDS] =
+        {"no", "so", "ea", "we", "ne", "nw", "se", "sw",
+         "ano", "aso", "aea", "awe", "ane", "anw", "ase", "asw"};
+
+    // commands of a session: a shade, then random moves and attacks
+    string script(const unsigned int seed) {
+        Rng rng(seed);
+        string commands = "s\n";
+        for (int i = 0; i < NUM_COMMANDS; ++i) {
+            commands += SCRIPT_COMMANDS[rng.next() % NUM_SCRIPT_COMMANDS];
+            commands += '\n';
+        } // for
+        return commands + "q\n";
+    } // script()
+
+    // plays a session on config with seed, counting into stats (if not NULL)
+    void play(const string &config, const unsigned int seed, TurnStats *stats) {
+        // (on one thread, so that the enemies' turns are counted too)
+        GameOptions options;
+        options.threads = 1;
+        istringstream in(script(seed));
+        ostringstream out;
+        Console::use(&in, &out);
+        Rng::current().seed(seed);
+        TurnStats::use(stats);
+        playGames(config, options);
+        TurnStats::use(NULL);
+        Console::use(NULL, NULL);
+    } // play()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 4) {
+        cerr << "Usage: " << argv[0] << " maxAllocations maxExceptions config ..." << endl;
+        return 2;
+    } // if
+    if (!TurnStats::ENABLED) {
+        cout << "Allocations and exceptions are not counted by this build (see TURN_STATS)." << endl;
+        return 2;
+    } // if
+    const uint64_t maxAllocations = atoi(argv[1]), maxThrows = atoi(argv[2]);
+
+    int numFailed = 0;
+    for (int i = 3; i < argc; ++i) {
+        const string config = argv[i];
+        for (unsigned int seed = 1; seed <= NUM_SEEDS; ++seed) {
+            TurnStats stats;
+            try {
+                play(config, seed, NULL);
+                play(config, seed, &stats);
+            } catch (GameException &e) {
+                cout << config << ": the game stopped on an error" << endl;
+                ++numFailed;
+                continue;
+            } // catch
+
+            const Histogram &allocations = stats.getTurnAllocations(), &throws = stats.getTurnThrows();
+            if (allocations.getMax() <= maxAllocations && throws.getMax() <= maxThrows) continue;
+            ++numFailed;
+            cout << "Over budget: " << config << " (seed " << seed << "): a turn made up to "
+                 << allocations.getMax() << " allocations (budget " << maxAllocations << ") and "
+                 << throws.getMax() << " game exceptions (budget " << maxThrows << ")" << endl;
+            stats.print(cout);
+        } // for
+    } // for
+    cout << (argc - 3) * NUM_SEEDS - numFailed << " of " << (argc - 3) * NUM_SEEDS
+         << " sessions within budget" << endl;
+    return numFailed ? 1 : 0;
+} // main()
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * flowFieldTest.cc
+ *
+ * Checks the incremental updates of FlowField (the distances to the PC that
+ * hard mode maintains): on every configuration given, on a generated board
+ * and on a board too large for a table of distances, walks the source from
+ * the PC's tile to random targets across the board, one step at a time (so
+ * that every step is an incremental update), and after every step compares
+ * every distance with those of a field computed from scratch, and with those
+ * of the layout's DistanceTable (except on the generated board).
+ *
+ * Usage: ./flowFieldTest config ...   (from the root of the repository)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include "game.h"
+#include "floor.h"
+#include "cell.h"
+#include "pc.h"
+#include "flowField.h"
+#include "layout.h"
+#include "distanceTable.h"
+#include "arena.h"
+#include "rng.h"
+#include "constants.h"
+
+using namespace std;
+using namespace constants;
+
+namespace {
+    // walks to random targets per board (fewer on the large board, whose 
+    // every check costs as much as checking several small ones), and most 
+    // steps per walk
+    const int NUM_TRIPS = 20, NUM_LARGE_TRIPS = 3;
+    const int MAX_STEPS = 400;
+
+    // name and dimensions of the large board (with more walkable tiles than 
+    // MAX_DISTANCE_TABLE_TILES)
+    const string LARGE_CONFIG = "large board";
+    const int LARGE_ROWS = 70, LARGE_COLS = 90;
+
+    // gets a chamber of LARGE_ROWS x LARGE_COLS split into a serpentine by 
+    // walls every WALL_SPACING columns (open at the bottom and top in turn), 
+    // with the PC in the middle
+    const int WALL_SPACING = 15;
+    string largeBoard() {
+        string board = string(LARGE_COLS, '-') + "\n";
+        for (int row = 1; row < LARGE_ROWS - 1; ++row) {
+            string line = "|" + string(LARGE_COLS - 2, '.') + "|\n";
+            for (int col = WALL_SPACING; col < LARGE_COLS - 1; col += WALL_SPACING) {
+                const bool openBelow = (col / WALL_SPACING) % 2;
+                if (openBelow ? row < LARGE_ROWS - 3 : row > 2) line[col] = '|';
+            } // for
+            board += line;
+        } // for
+        board[(LARGE_ROWS / 2) * (LARGE_COLS + 1) + LARGE_COLS / 2] = '@';
+        return board + string(LARGE_COLS, '-') + "\n";
+    } // largeBoard()
+
+    // gets the directions in which c has a walkable neighbor
+    unsigned int neighborMask(const Cell &c) {
+        unsigned int mask = 0;
+        for (int dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+            if (c.getNeighbor(dir)) mask |= 1u << dir;
+        } // for
+        return mask;
+    } // neighborMask()
+
+    /*******************************************************************************
+     * matches(field, scratch, source, floor, walkable) determines if field holds
+     *  the distances from source to the walkable cells of floor, as computed
+     *  from scratch into scratch, printing the first difference
+     * time: O(#walkable cells)
+     * *****************************************************************************/
+    bool matches(const FlowField &field, FlowField &scratch, Cell &source, const Floor &floor,
+                 const vector<Cell *> &walkable) {
+        scratch.resize(floor.getNumRows(), floor.getNumCols());
+        scratch.setSource(source);
+        for (vector<Cell *>::const_iterator it = walkable.begin(); it != walkable.end(); ++it) {
+            if (field.distance(**it) == scratch.distance(**it)) continue;
+            cerr << "distance of (" << (*it)->getRow() << ", " << (*it)->getCol() << ") from ("
+                 << source.getRow() << ", " << source.getCol() << "): " << field.distance(**it)
+                 << " instead of " << scratch.distance(**it) << endl;
+            return false;
+        } // for
+        return true;
+    } // matches()
+
+    /*******************************************************************************
+     * matchesTable(field, source, table, row, walkable) determines if table 
+     *  holds the distances from source that field holds, printing the first 
+     *  difference
+     * time: O(#walkable cells) (and a search on large boards)
+     * *****************************************************************************/
+    bool matchesTable(const FlowField &field, const Cell &source, const DistanceTable &table,
+                      DistanceTable::Row &row, const vector<Cell *> &walkable) {
+        for (vector<Cell *>::const_iterator it = walkable.begin(); it != walkable.end(); ++it) {
+            const unsigned short d = table.distance(source.getRow(), source.getCol(), 
+                                                    (*it)->getRow(), (*it)->getCol(), row);
+            const int expected = field.distance(**it);
+            if (expected == FlowField::UNREACHABLE ? d == DistanceTable::UNREACHABLE : d == expected) continue;
+            cerr << "table distance of (" << (*it)->getRow() << ", " << (*it)->getCol() << ") from ("
+                 << source.getRow() << ", " << source.getCol() << "): " << d << " instead of "
+                 << expected << endl;
+            return false;
+        } // for
+        return true;
+    } // matchesTable()
+
+    /*******************************************************************************
+     * walk(config, seed, numTrips) walks the source of a field to numTrips 
+     *  targets across the first floor of config, checking the field after 
+     *  every step
+     * notes: returns the number of steps taken, or -1 (printing why) if the
+     *        field was wrong
+     * time: O(numTrips * MAX_STEPS * #walkable cells)
+     * *****************************************************************************/
+    int walk(const string &config, const unsigned int seed, const int numTrips) {
+        GameOptions options;
+        options.threads = 1;
+        Rng::current().seed(seed);
+        PC *pc = createRace('s');
+        Floor *floor = new Floor(1, config, *pc, options);
+
+        vector<Cell *> walkable;
+        for (int row = 0; row < floor->getNumRows(); ++row) {
+            for (int col = 0; col < floor->getNumCols(); ++col) {
+                Cell *cell = floor->getCell(row, col);
+                if (cell && cell->isWalkableTile()) walkable.push_back(cell);
+            } // for
+        } // for
+
+        // (generated boards have no layout to look up)
+        const DistanceTable *table = config == EMPTY_CONFIG ? NULL : &Layout::load(config).getDistances();
+        DistanceTable::Row row;
+
+        // walks along the shortest paths to every target (jumping to targets
+        // that cannot be reached, which recomputes the field)
+        FlowField field(floor->getNumRows(), floor->getNumCols());
+        FlowField toTarget(floor->getNumRows(), floor->getNumCols());
+        FlowField scratch(floor->getNumRows(), floor->getNumCols());
+        // (starts on the PC's tile, where the PC stands once the floor is entered)
+        int pcRow, pcCol;
+        floor->getPCCell().first(pcRow, pcCol);
+        Cell *source = floor->getCell(pcRow, pcCol);
+        field.setSource(*source);
+        Rng rng(seed);
+        int numSteps = 0;
+        bool correct = matches(field, scratch, *source, *floor, walkable)
+                       && (!table || matchesTable(scratch, *source, *table, row, walkable));
+        for (int trip = 0; correct && trip < numTrips; ++trip) {
+            Cell &target = *walkable[rng.next() % walkable.size()];
+            toTarget.resize(floor->getNumRows(), floor->getNumCols());
+            toTarget.setSource(target);
+            for (int step = 0; correct && step < MAX_STEPS && source != &target; ++step) {
+                const int dir = toTarget.downhill(*source, neighborMask(*source));
+                source = dir == -1 ? &target : source->getNeighbor(dir);
+                field.setSource(*source);
+                correct = matches(field, scratch, *source, *floor, walkable)
+                          && (!table || matchesTable(scratch, *source, *table, row, walkable));
+                ++numSteps;
+            } // for
+        } // for
+
+        delete floor;
+        delete pc;
+        Arena::use(NULL);
+        return correct ? numSteps : -1;
+    } // walk()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " config ..." << endl;
+        return 2;
+    } // if
+
+    // the configurations given, then a generated board and a large one
+    vector<string> configs(argv + 1, argv + argc);
+    configs.push_back(EMPTY_CONFIG);
+    Layout::define(LARGE_CONFIG, largeBoard());
+    configs.push_back(LARGE_CONFIG);
+    int numFailed = 0;
+    for (vector<string>::const_iterator it = configs.begin(); it != configs.end(); ++it) {
+        const int numTrips = *it == LARGE_CONFIG ? NUM_LARGE_TRIPS : NUM_TRIPS;
+        const int numSteps = walk(*it, it - configs.begin() + 1, numTrips);
+        if (numSteps == -1) {
+            cout << "Wrong distances on " << *it << endl;
+            ++numFailed;
+        } else {
+            cout << *it << ": " << numSteps << " steps checked" << endl;
+        } // else
+    } // for
+    cout << configs.size() - numFailed << " of " << configs.size() << " boards passed" << endl;
+    return numFailed ? 1 : 0;
+} // main()
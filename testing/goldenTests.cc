@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * goldenTests.cc
+ *
+ * Runs the golden tests listed in a manifest (see manifest.txt): plays every
+ * test's input through the game, in this process and several at once, and
+ * compares what is printed with the recorded output, printing a unified diff
+ * for every test that fails.
+ *
+ * With --compiled=DIR, every test is played on its configuration as compiled
+ * into DIR by dc-compile (DIR/<name>.dcl for configuration <name>.txt), which
+ * must play out exactly as the configuration itself does.
+ *
+ * Usage: ./goldenTests [--compiled=DIR] [manifest]   (from the root of the
+ *        repository)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include "game.h"
+#include "console.h"
+#include "workerPool.h"
+#include "rng.h"
+
+using namespace std;
+
+namespace {
+    // lines of context around the changes in a diff
+    const int CONTEXT = 3;
+
+    // a test, as listed in the manifest
+    struct Case {
+        string name;
+        string config;
+        unsigned int seed;
+        GameOptions options;
+
+        // what the test feeds the game, what it expects and what it got
+        string input, expected, actual;
+    };
+
+    // gets the contents of filename without carriage returns (false if it cannot be read)
+    bool readFile(const string &filename, string &contents) {
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in.good()) return false;
+        ostringstream buffer;
+        buffer << in.rdbuf();
+        contents = buffer.str();
+        contents.erase(remove(contents.begin(), contents.end(), '\r'), contents.end());
+        return true;
+    } // readFile()
+
+    /*******************************************************************************
+     * readManifest(filename, cases) adds the tests listed in filename to cases,
+     *  with their inputs and expected outputs (from the manifest's directory)
+     * notes: returns false, printing why, if a line or a file is invalid
+     * time: O(size of the tests)
+     * *****************************************************************************/
+    bool readManifest(const string &filename, vector<Case> &cases) {
+        ifstream in(filename.c_str());
+        if (!in.good()) {
+            cerr << "Cannot read " << filename << endl;
+            return false;
+        } // if
+        const size_t slash = filename.find_last_of("/\\");
+        const string dir = slash == string::npos ? "" : filename.substr(0, slash + 1);
+
+        string line;
+        for (int lineNum = 1; getline(in, line); ++lineNum) {
+            if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+            if (line.empty() || line[0] == '#') continue;
+            istringstream fields(line);
+            Case c;
+            string option;
+            if (!(fields >> c.name >> c.config >> c.seed)) {
+                cerr << filename << ":" << lineNum << ": expected a name, a configuration and a seed" << endl;
+                return false;
+            } // if
+            while (fields >> option) {
+                if (!parseOption(option, c.options)) {
+                    cerr << filename << ":" << lineNum << ": invalid option " << option << endl;
+                    return false;
+                } // if
+            } // while
+            if (!readFile(dir + c.name + ".in", c.input) || !readFile(dir + c.name + ".out", c.expected)) {
+                cerr << filename << ":" << lineNum << ": cannot read the files of " << c.name << endl;
+                return false;
+            } // if
+            cases.push_back(c);
+        } // for
+        return true;
+    } // readManifest()
+
+    // gets the compiled form of configuration filename in dir
+    string compiledConfig(const string &dir, const string &filename) {
+        const size_t slash = filename.find_last_of("/\\");
+        const string name = slash == string::npos ? filename : filename.substr(slash + 1);
+        return dir + "/" + name.substr(0, name.find_last_of('.')) + ".dcl";
+    } // compiledConfig()
+
+    // plays c, storing what the game prints
+    void play(Case &c) {
+        istringstream in(c.input);
+        ostringstream out;
+        Console::use(&in, &out);
+        Rng::current().seed(c.seed);
+        try {
+            playGames(c.config, c.options);
+        } catch (GameException &e) {
+            out << "(the game stopped on an error)" << endl;
+        } // catch
+        Console::use(NULL, NULL);
+        c.actual = out.str();
+    } // play()
+
+    // splits text into lines
+    vector<string> lines(const string &text) {
+        vector<string> result;
+        istringstream in(text);
+        string line;
+        while (getline(in, line)) result.push_back(line);
+        return result;
+    } // lines()
+
+    /*******************************************************************************
+     * printDiff(out, c) prints a unified diff from the expected to the actual
+     *  output of c
+     * notes: the lines that differ are matched by a longest common subsequence,
+     *        once the lines both outputs start and end with are set aside
+     * time: O(#lines + #lines that differ in expected * #lines that differ in actual)
+     * *****************************************************************************/
+    void printDiff(ostream &out, const Case &c) {
+        const vector<string> a = lines(c.expected), b = lines(c.actual);
+        int prefix = 0, suffix = 0;
+        while (prefix < (int) a.size() && prefix < (int) b.size() && a[prefix] == b[prefix]) ++prefix;
+        while (suffix < (int) a.size() - prefix && suffix < (int) b.size() - prefix
+               && a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix]) ++suffix;
+        const int n = a.size() - prefix - suffix, m = b.size() - prefix - suffix;
+
+        // common[i][j] is the length of the longest common subsequence of the
+        // middles of a and b from i and j on
+        vector<vector<int> > common(n + 1, vector<int>(m + 1, 0));
+        for (int i = n - 1; i >= 0; --i) {
+            for (int j = m - 1; j >= 0; --j) {
+                common[i][j] = a[prefix + i] == b[prefix + j] ? common[i + 1][j + 1] + 1
+                                                              : max(common[i + 1][j], common[i][j + 1]);
+            } // for
+        } // for
+
+        // edit script: ' ' keeps a line of both, '-' drops one of a, '+' adds one of b
+        vector<pair<char, const string *> > edits;
+        for (int i = 0; i < prefix; ++i) edits.push_back(make_pair(' ', &a[i]));
+        int i = 0, j = 0;
+        while (i < n || j < m) {
+            if (i < n && j < m && a[prefix + i] == b[prefix + j]) {
+                edits.push_back(make_pair(' ', &a[prefix + i]));
+                ++i;
+                ++j;
+            } else if (j == m || (i < n && common[i + 1][j] >= common[i][j + 1])) {
+                edits.push_back(make_pair('-', &a[prefix + i++]));
+            } else {
+                edits.push_back(make_pair('+', &b[prefix + j++]));
+            } // else
+        } // while
+        for (int k = suffix; k > 0; --k) edits.push_back(make_pair(' ', &a[a.size() - k]));
+
+        // groups the changes into hunks, with CONTEXT lines around them
+        out << "--- " << c.name << ".out" << endl << "+++ " << c.name << " (actual)" << endl;
+        const int numEdits = edits.size();
+        int aLine = 0, bLine = 0;
+        for (int k = 0; k < numEdits; ) {
+            if (edits[k].first == ' ') {
+                ++aLine;
+                ++bLine;
+                ++k;
+                continue;
+            } // if
+
+            // the hunk ends once CONTEXT * 2 unchanged lines follow a change
+            const int start = max(k - CONTEXT, 0);
+            int end = k, lastChange = k;
+            while (end < numEdits && end - lastChange <= CONTEXT * 2) {
+                if (edits[end].first != ' ') lastChange = end;
+                ++end;
+            } // while
+            end = min(lastChange + CONTEXT + 1, numEdits);
+
+            const int aStart = aLine - (k - start), bStart = bLine - (k - start);
+            int aCount = 0, bCount = 0;
+            for (int e = start; e < end; ++e) {
+                if (edits[e].first != '+') ++aCount;
+                if (edits[e].first != '-') ++bCount;
+            } // for
+            out << "@@ -" << aStart + 1 << "," << aCount << " +" << bStart + 1 << "," << bCount << " @@" << endl;
+            for (int e = start; e < end; ++e) out << edits[e].first << *edits[e].second << endl;
+            aLine = aStart + aCount;
+            bLine = bStart + bCount;
+            k = end;
+        } // for
+    } // printDiff()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    string manifest = "testing/manifest.txt", compiledDir;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg.compare(0, 11, "--compiled=") == 0) compiledDir = arg.substr(11);
+        else manifest = arg;
+    } // for
+    vector<Case> cases;
+    if (!readManifest(manifest, cases)) return 2;
+    if (!compiledDir.empty()) {
+        for (vector<Case>::iterator it = cases.begin(); it != cases.end(); ++it) {
+            it->config = compiledConfig(compiledDir, it->config);
+        } // for
+    } // if
+
+    // plays every test on its own thread's streams
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    WorkerPool workers(max((int) thread::hardware_concurrency(), 1) - 1);
+    workers.run(cases.size(), [&cases](const int i) { play(cases[i]); });
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    int numFailed = 0;
+    for (vector<Case>::const_iterator it = cases.begin(); it != cases.end(); ++it) {
+        if (it->actual == it->expected) continue;
+        ++numFailed;
+        cout << "Test failed: " << it->name << " (" << it->config << ", seed " << it->seed << ")" << endl;
+        printDiff(cout, *it);
+    } // for
+    cout << cases.size() - numFailed << " of " << cases.size() << " tests passed in "
+         << seconds << " s" << endl;
+    return numFailed ? 1 : 0;
+} // main()
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * dcCompile.cc
+ *
+ * Compiles a configuration file into the binary form the game maps into
+ * memory instead of parsing it (see Layout::compile()): for every board of
+ * the configuration, its tiles, chambers, the walkable neighbors of every tile
+ * and the hoards its dragons guard, behind a versioned header and a checksum.
+ * Every floor is built first, so that invalid configurations are rejected here
+ * rather than when played.
+ *
+ * Compiled files are played like configuration files (e.g. ./dc full.dcl);
+ * they must be compiled again whenever the game's version of the format
+ * changes.
+ *
+ * Usage: ./dc-compile config [output]   (output defaults to config, with the
+ *        extension .dcl)
+ * ****************************************************************************/
+
+#include <iostream>
+#include <string>
+#include "game.h"
+#include "floor.h"
+#include "layout.h"
+#include "pc.h"
+#include "arena.h"
+#include "constants.h"
+
+using namespace std;
+
+namespace {
+    // extension of compiled configurations
+    const string COMPILED_EXTENSION = ".dcl";
+
+    // gets filename with its extension replaced by the compiled one
+    string compiledName(const string &filename) {
+        const size_t dot = filename.find_last_of('.');
+        const size_t slash = filename.find_last_of("/\\");
+        const bool hasExtension = dot != string::npos && (slash == string::npos || dot > slash);
+        return (hasExtension ? filename.substr(0, dot) : filename) + COMPILED_EXTENSION;
+    } // compiledName()
+
+    // determines if every floor of the configuration in filename can be played,
+    // printing why not
+    bool isPlayable(const string &filename) {
+        GameOptions options;
+        options.compat = true;
+        options.threads = 1;
+        PC *pc = createRace('s');
+        bool playable = true;
+        for (int floorNum = 1; playable && floorNum <= constants::NUM_FLOORS; ++floorNum) {
+            try {
+                delete new Floor(floorNum, filename, *pc, options);
+            } catch (GameException &e) {
+                cerr << "Floor " << floorNum << ": ";
+                playable = false;
+            } // catch
+        } // for
+        delete pc;
+        Arena::use(NULL);
+        return playable;
+    } // isPlayable()
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " config [output]" << endl;
+        return 2;
+    } // if
+    const string filename = argv[1];
+    const string output = argc > 2 ? argv[2] : compiledName(filename);
+
+    try {
+        Layout::load(filename);
+        if (!isPlayable(filename)) {
+            cerr << filename << " cannot be played." << endl;
+            return 1;
+        } // if
+        if (!Layout::compile(filename, output)) {
+            cerr << "Cannot write " << output << endl;
+            return 1;
+        } // if
+    } catch (InvalidFile &e) {
+        cerr << "Cannot read " << filename << endl;
+        return 1;
+    } catch (GameException &e) {
+        cerr << filename << " is not a valid configuration." << endl;
+        return 1;
+    } // catch
+    return 0;
+} // main()